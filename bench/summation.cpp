@@ -0,0 +1,154 @@
+
+// Compares the accuracy and speed of each summation strategy on sums with known values
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <mth/comp.h>
+#include <mth/series.h>
+#include <mth/summation.h>
+
+struct Case {
+
+    const char *name;
+
+    std::vector<mth::comp> values;
+
+    // Accurate sum to measure errors against
+    double exact;
+};
+
+struct Strategy {
+
+    const char *name;
+
+    mth::Summation method;
+};
+
+// Returns the average time in nanoseconds per value of running body over a case, and its error
+template <typename F>
+void measure(const Case &test, const F &body, double &nanoseconds, double &error) {
+
+    constexpr size_t repeats = 5;
+
+    auto result = mth::comp{0};
+    auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < repeats; i++) {
+
+        result = body(test.values);
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    nanoseconds = elapsed.count() / (repeats * test.values.size());
+    error = std::abs(result.real() - test.exact) / std::abs(test.exact);
+}
+
+int main() {
+
+    constexpr size_t count = 1 << 22;
+
+    std::vector<Case> cases;
+
+    {
+        // Terms of the Basel problem, with the exact sum of the first count terms found by summing smallest first
+        Case basel {"1/n^2", std::vector<mth::comp>(count), 0.0};
+
+        long double exact = 0.0L;
+
+        for (size_t n = count; n >= 1; n--) {
+
+            auto term = 1.0L / (static_cast<long double>(n) * n);
+
+            basel.values[n - 1] = mth::comp(static_cast<double>(term));
+            exact += term;
+        }
+
+        basel.exact = static_cast<double>(exact);
+        cases.push_back(basel);
+    }
+
+    {
+        // A repeated value with no exact binary representation
+        cases.push_back({"0.1", std::vector<mth::comp>(count, mth::comp(0.1)), 0.1 * count});
+    }
+
+    {
+        // Alternating harmonic terms, whose partial sums cancel heavily
+        Case alternating {"(-1)^n/n", std::vector<mth::comp>(count), 0.0};
+
+        long double exact = 0.0L;
+
+        for (size_t n = count; n >= 1; n--) {
+
+            auto term = (n % 2 == 1 ? 1.0L : -1.0L) / static_cast<long double>(n);
+
+            alternating.values[n - 1] = mth::comp(static_cast<double>(term));
+            exact += term;
+        }
+
+        alternating.exact = static_cast<double>(exact);
+        cases.push_back(alternating);
+    }
+
+    std::vector<Strategy> strategies {
+
+        {"naive", mth::Summation::Naive},
+        {"kahan", mth::Summation::Kahan},
+        {"pairwise", mth::Summation::Pairwise}
+    };
+
+    std::cout << std::left << std::setw(10) << "case" << std::setw(10) << "strategy" << std::setw(10) << "method"
+              << std::setw(14) << "ns/value" << std::setw(14) << "rel. error" << "digits/ns" << std::endl;
+
+    for (const auto &test : cases) {
+
+        for (const auto &strategy : strategies) {
+
+            std::vector<std::pair<const char *, std::function<mth::comp(const std::vector<mth::comp> &)>>> methods {
+
+                {"array", [&] (const std::vector<mth::comp> &values) {
+
+                    return mth::sum(values, strategy.method);
+                }},
+
+                {"stream", [&] (const std::vector<mth::comp> &values) {
+
+                    mth::Accumulator accumulator(strategy.method);
+
+                    for (const auto &value : values) accumulator.add(value);
+
+                    return accumulator.total();
+                }},
+
+                {"series", [&] (const std::vector<mth::comp> &values) {
+
+                    // A fresh series each time so nothing is cached
+                    mth::Series series([&values] (size_t index) { return values[index]; }, strategy.method);
+
+                    return series.getPartial(values.size() - 1);
+                }}
+            };
+
+            for (const auto &method : methods) {
+
+                double nanoseconds;
+                double error;
+
+                measure(test, method.second, nanoseconds, error);
+
+                // Correct digits gained per nanosecond spent on each value
+                auto digits = error == 0.0 ? 16.0 : -std::log10(error);
+
+                std::cout << std::left << std::setw(10) << test.name << std::setw(10) << strategy.name
+                          << std::setw(10) << method.first << std::setw(14) << nanoseconds << std::setw(14) << error
+                          << digits / nanoseconds << std::endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef mth_cache_h__
+#define mth_cache_h__
+
+/* <mth/cache.h> - concurrent cache header
+ *      This includes the template class tcache, an append-only sequence
+ *      of values indexed from zero. Values are stored in segments that
+ *      double in size and never move once written, so any index below
+ *      size() can be read without locking while another thread appends.
+ *      Appends themselves must be serialized by the owner, typically
+ *      with a mutex held while the new values are computed so each value
+ *      is only computed once.
+ */
+
+#include <array>
+#include <atomic>
+
+#include <mth/mth.h>
+
+namespace mth {
+
+    template <typename T>
+    class tcache {
+
+    private:
+
+        // Enough doubling segments that the capacity can't be exhausted
+        static constexpr size_t SEGMENTS = 48;
+
+        size_t firstSegment;
+
+        std::array<std::atomic<T *>, SEGMENTS> segments;
+
+        // Number of published values; released after each value is written
+        std::atomic<size_t> count {0};
+
+        // Finds the segment holding an index and the offset within it
+        // Segment k holds indices from firstSegment * (2^k - 1) up to firstSegment * (2^(k + 1) - 1)
+        void locate(size_t index, size_t &segment, size_t &offset) const noexcept {
+
+            auto blocks = index / firstSegment + 1;
+
+            segment = 0;
+
+            while (blocks >>= 1) segment++;
+
+            offset = index - firstSegment * ((size_t{1} << segment) - 1);
+        }
+
+    public:
+
+        // Initialize empty, with the first segment holding firstSegment values
+        explicit tcache(size_t firstSegment = 64) noexcept
+            :firstSegment(firstSegment == 0 ? 1 : firstSegment) {
+
+            for (auto &segment : segments) {
+
+                segment.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        ~tcache() {
+
+            for (auto &segment : segments) {
+
+                delete[] segment.load(std::memory_order_relaxed);
+            }
+        }
+
+        tcache(const tcache &) = delete;
+        tcache &operator=(const tcache &) = delete;
+
+        // Returns the number of values that can be read
+        size_t size() const noexcept {
+
+            return count.load(std::memory_order_acquire);
+        }
+
+        // Read a value; index must be below a value previously returned by size()
+        const T &operator[](size_t index) const noexcept {
+
+            size_t segment;
+            size_t offset;
+
+            locate(index, segment, offset);
+
+            return segments[segment].load(std::memory_order_acquire)[offset];
+        }
+
+        // Read a value if it has been published, returning whether it was
+        bool tryGet(size_t index, T &value) const noexcept {
+
+            if (index >= size()) return false;
+
+            value = (*this)[index];
+
+            return true;
+        }
+
+        // Append a value, making it visible to readers
+        // Must not be called concurrently with another push
+        void push(const T &value) {
+
+            auto index = count.load(std::memory_order_relaxed);
+
+            size_t segment;
+            size_t offset;
+
+            locate(index, segment, offset);
+
+            auto storage = segments[segment].load(std::memory_order_relaxed);
+
+            if (storage == nullptr) {
+
+                storage = new T[firstSegment << segment];
+                segments[segment].store(storage, std::memory_order_release);
+            }
+
+            storage[offset] = value;
+
+            count.store(index + 1, std::memory_order_release);
+        }
+    };
+}
+
+#endif
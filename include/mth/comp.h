@@ -90,7 +90,8 @@ namespace mth {
             auto ls = static_cast<double>(absSqr());
             
             // If the magnitude is zero don't bother with sqrt
-            if (util::isZero(ls)) return 0.0;
+            // Compared exactly, since small magnitudes squared can fall below epsilon long before they vanish
+            if (ls == 0.0) return 0.0;
 
             return std::sqrt(ls);
         }
@@ -289,7 +290,7 @@ namespace mth {
 
         auto exponent = mth::i<T> * z;
 
-        return (exp(exponent) + exp(-exponent)) / 2;
+        return (exp(exponent) + exp(-exponent)) / static_cast<T>(2);
     }
 
     // Calculate sin(z)
@@ -298,7 +299,7 @@ namespace mth {
 
         auto exponent = mth::i<T> * z;
 
-        return (exp(exponent) - exp(-exponent)) / (2 * mth::i<T>);
+        return (exp(exponent) - exp(-exponent)) / (static_cast<T>(2) * mth::i<T>);
     }
 
     // Calculate a complex power of a complex number using exp and log
@@ -398,7 +399,7 @@ namespace mth {
     template <typename T>
     constexpr tcomp<T> operator-(const T &lhs, const tcomp<T> &rhs) noexcept {
 
-        auto result = lhs;
+        auto result = tcomp<T>(lhs);
 
         return result -= rhs;
     }
@@ -0,0 +1,553 @@
+#ifndef mth_cubature_h__
+#define mth_cubature_h__
+
+/* <mth/cubature.h> - multi-dimensional integration header
+ *      Defines integration of arbitrary callables over boxes given by
+ *      mth::tvec bounds. integrateBox() uses the adaptive Genz-Malik rule,
+ *      bisecting the region with the largest error estimate along its
+ *      roughest axis. quasiMonteCarlo() averages over randomly shifted
+ *      Sobol or Halton low-discrepancy points, estimating its error from
+ *      the spread between independent shifts so it can stop early.
+ *      Samples can be evaluated in batches on the shared thread pool.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/vec.h>
+#include <mth/parallel.h>
+#include <mth/quadrature.h>
+
+namespace mth {
+
+    // Low-discrepancy sequences for quasi-Monte Carlo sampling
+    enum class LowDiscrepancy {
+
+        Sobol,
+        Halton
+    };
+
+    // Stopping criteria and evaluation policy for cubature
+    struct CubatureOptions {
+
+        // Stop once the error estimate is at most max(absTolerance, relTolerance * |value|)
+        double absTolerance = 1e-6;
+        double relTolerance = 1e-6;
+
+        // Give up after this many function evaluations
+        size_t maxEvaluations = 1000000;
+
+        // Sequence sampled by quasiMonteCarlo
+        LowDiscrepancy sequence = LowDiscrepancy::Sobol;
+
+        // Number of independent random shifts quasiMonteCarlo estimates its error from
+        size_t replicates = 8;
+
+        // Number of sequence points per replicate evaluated between error checks in quasiMonteCarlo
+        size_t batchSize = 256;
+
+        // Seed for the random shifts, so results are reproducible
+        uint64_t seed = 0;
+
+        // With Execution::Parallel each batch of samples or regions is evaluated on the shared thread pool
+        Execution execution = Execution::Serial;
+    };
+
+    namespace cubature {
+
+        // Largest dimension supported by sobol
+        constexpr size_t sobolMaxDimension = 10;
+
+        // Bits of precision in sobol points
+        constexpr size_t sobolBits = 32;
+
+        // Primitive polynomial degree, coefficients and initial direction numbers (Joe and Kuo) for dimensions 2 onwards
+        struct SobolParameters {
+
+            unsigned degree;
+            unsigned coefficients;
+
+            std::array<uint32_t, 5> initial;
+        };
+
+        constexpr std::array<SobolParameters, sobolMaxDimension - 1> sobolParameters {{
+
+            {1, 0, {1}},
+            {2, 1, {1, 3}},
+            {3, 1, {1, 3, 1}},
+            {3, 2, {1, 1, 1}},
+            {4, 1, {1, 1, 3, 3}},
+            {4, 4, {1, 3, 5, 13}},
+            {5, 2, {1, 1, 5, 5, 17}},
+            {5, 4, {1, 1, 5, 5, 5}},
+            {5, 7, {1, 1, 7, 11, 19}}
+        }};
+
+        // Returns the direction numbers of a dimension, scaled to sobolBits bits
+        inline std::array<uint32_t, sobolBits> sobolDirections(size_t dimension) {
+
+            std::array<uint32_t, sobolBits> directions {};
+
+            if (dimension == 0) {
+
+                for (size_t k = 0; k < sobolBits; k++) {
+
+                    directions[k] = uint32_t{1} << (sobolBits - 1 - k);
+                }
+
+                return directions;
+            }
+
+            const auto &parameters = sobolParameters[dimension - 1];
+            auto s = parameters.degree;
+
+            for (size_t k = 0; k < sobolBits; k++) {
+
+                if (k < s) {
+
+                    directions[k] = parameters.initial[k] << (sobolBits - 1 - k);
+
+                } else {
+
+                    auto next = directions[k - s] ^ (directions[k - s] >> s);
+
+                    for (size_t j = 1; j < s; j++) {
+
+                        if ((parameters.coefficients >> (s - 1 - j)) & 1) next ^= directions[k - j];
+                    }
+
+                    directions[k] = next;
+                }
+            }
+
+            return directions;
+        }
+
+        // Primes used as Halton bases
+        constexpr std::array<unsigned, 16> haltonBases {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+
+        // Returns the base b digits of index reflected about the radix point
+        inline double radicalInverse(size_t index, unsigned base) {
+
+            auto result = 0.0;
+            auto scale = 1.0 / base;
+
+            while (index > 0) {
+
+                result += scale * static_cast<double>(index % base);
+
+                index /= base;
+                scale /= base;
+            }
+
+            return result;
+        }
+
+        // Genz-Malik generator offsets as fractions of the half-widths
+        const double genzMalikInner = std::sqrt(9.0 / 70.0);
+        const double genzMalikOuter = std::sqrt(9.0 / 10.0);
+        const double genzMalikCorner = std::sqrt(9.0 / 19.0);
+
+        // A box with its Genz-Malik estimate
+        template <typename V, typename T, size_t N>
+        struct Region {
+
+            tvec<T, N> centre;
+            tvec<T, N> halfWidth;
+
+            V value;
+            double error;
+
+            // Axis with the largest fourth difference, which is split next
+            size_t roughestAxis;
+        };
+
+        // Number of points the Genz-Malik rule evaluates in N dimensions
+        constexpr size_t genzMalikPoints(size_t n) {
+
+            return (size_t{1} << n) + 2 * n * n + 2 * n + 1;
+        }
+
+        // Apply the degree 7 Genz-Malik rule with its embedded degree 5 rule to a box
+        template <typename V, typename T, size_t N, typename F>
+        Region<V, T, N> genzMalik(const F &function, const tvec<T, N> &centre, const tvec<T, N> &halfWidth) {
+
+            using quadrature::scale;
+            using quadrature::norm;
+
+            constexpr auto n = static_cast<double>(N);
+
+            auto at = [&] (const std::array<double, N> &offsets) {
+
+                auto point = centre;
+
+                for (size_t k = 0; k < N; k++) {
+
+                    point[k] += static_cast<T>(offsets[k] * static_cast<double>(halfWidth[k]));
+                }
+
+                return V(function(point));
+            };
+
+            std::array<double, N> offsets {};
+
+            V centreValue = at(offsets);
+
+            V innerSum {};
+            V outerSum {};
+            V pairSum {};
+            V cornerSum {};
+
+            Region<V, T, N> result {centre, halfWidth, V{}, 0.0, 0};
+
+            auto roughest = -1.0;
+
+            for (size_t k = 0; k < N; k++) {
+
+                offsets[k] = genzMalikInner;
+                V inner = at(offsets);
+                offsets[k] = -genzMalikInner;
+                inner += at(offsets);
+
+                offsets[k] = genzMalikOuter;
+                V outer = at(offsets);
+                offsets[k] = -genzMalikOuter;
+                outer += at(offsets);
+
+                offsets[k] = 0.0;
+
+                innerSum += inner;
+                outerSum += outer;
+
+                // Fourth difference along this axis; the inner and outer offsets squared are in ratio 1 / 7
+                auto twiceCentre = scale(centreValue, 2.0);
+                auto roughness = norm(inner - twiceCentre - scale(outer - twiceCentre, 1.0 / 7.0));
+
+                if (roughness > roughest) {
+
+                    roughest = roughness;
+                    result.roughestAxis = k;
+                }
+            }
+
+            for (size_t j = 0; j < N; j++) {
+
+                for (size_t k = j + 1; k < N; k++) {
+
+                    for (auto signJ : {-1.0, 1.0}) {
+
+                        for (auto signK : {-1.0, 1.0}) {
+
+                            offsets[j] = signJ * genzMalikOuter;
+                            offsets[k] = signK * genzMalikOuter;
+
+                            pairSum += at(offsets);
+                        }
+                    }
+
+                    offsets[j] = 0.0;
+                    offsets[k] = 0.0;
+                }
+            }
+
+            for (size_t corner = 0; corner < (size_t{1} << N); corner++) {
+
+                for (size_t k = 0; k < N; k++) {
+
+                    offsets[k] = (corner >> k) & 1 ? genzMalikCorner : -genzMalikCorner;
+                }
+
+                cornerSum += at(offsets);
+            }
+
+            auto degree7 = scale(centreValue, (12824.0 - 9120.0 * n + 400.0 * n * n) / 19683.0)
+                         + scale(innerSum, 980.0 / 6561.0)
+                         + scale(outerSum, (1820.0 - 400.0 * n) / 19683.0)
+                         + scale(pairSum, 200.0 / 19683.0)
+                         + scale(cornerSum, 6859.0 / 19683.0 / static_cast<double>(size_t{1} << N));
+
+            auto degree5 = scale(centreValue, (729.0 - 950.0 * n + 50.0 * n * n) / 729.0)
+                         + scale(innerSum, 245.0 / 486.0)
+                         + scale(outerSum, (265.0 - 100.0 * n) / 1458.0)
+                         + scale(pairSum, 25.0 / 729.0);
+
+            auto volume = 1.0;
+
+            for (size_t k = 0; k < N; k++) {
+
+                volume *= 2.0 * static_cast<double>(halfWidth[k]);
+            }
+
+            result.value = scale(degree7, volume);
+            result.error = std::abs(volume) * norm(degree7 - degree5);
+
+            return result;
+        }
+
+        // Returns whether an error estimate meets the tolerances in options
+        template <typename V>
+        bool isSettled(const V &value, double error, const CubatureOptions &options) {
+
+            return error <= std::max(options.absTolerance, options.relTolerance * quadrature::norm(value));
+        }
+    }
+
+    // Returns a point of the Sobol sequence in [0, 1)^N, in Gray code order
+    template <typename T, size_t N>
+    tvec<T, N> sobol(size_t index) {
+
+        static_assert(N <= cubature::sobolMaxDimension, "mth::sobol supports at most 10 dimensions");
+
+        // Direction numbers are built once per dimension count
+        static const auto directions = [] {
+
+            std::array<std::array<uint32_t, cubature::sobolBits>, N> result;
+
+            for (size_t k = 0; k < N; k++) {
+
+                result[k] = cubature::sobolDirections(k);
+            }
+
+            return result;
+        }();
+
+        auto gray = index ^ (index >> 1);
+
+        tvec<T, N> result;
+
+        for (size_t k = 0; k < N; k++) {
+
+            uint32_t bits = 0;
+
+            for (size_t j = 0; j < cubature::sobolBits && (gray >> j) != 0; j++) {
+
+                if ((gray >> j) & 1) bits ^= directions[k][j];
+            }
+
+            result[k] = static_cast<T>(std::ldexp(static_cast<double>(bits), -static_cast<int>(cubature::sobolBits)));
+        }
+
+        return result;
+    }
+
+    // Returns a point of the Halton sequence in (0, 1)^N, skipping the origin
+    template <typename T, size_t N>
+    tvec<T, N> halton(size_t index) {
+
+        static_assert(N <= cubature::haltonBases.size(), "mth::halton supports at most 16 dimensions");
+
+        tvec<T, N> result;
+
+        for (size_t k = 0; k < N; k++) {
+
+            result[k] = static_cast<T>(cubature::radicalInverse(index + 1, cubature::haltonBases[k]));
+        }
+
+        return result;
+    }
+
+    // Integrate over the box [lower, upper] with the adaptive Genz-Malik rule
+    template <typename F, typename T, size_t N>
+    auto integrateBox(const F &function, const tvec<T, N> &lower, const tvec<T, N> &upper, const CubatureOptions &options = {}) {
+
+        using V = typename std::decay<decltype(function(lower))>::type;
+        using Region = cubature::Region<V, T, N>;
+
+        constexpr auto pointsPerRegion = cubature::genzMalikPoints(N);
+
+        auto compare = [] (const Region &lhs, const Region &rhs) { return lhs.error < rhs.error; };
+
+        auto centre = lower;
+        auto halfWidth = lower;
+
+        for (size_t k = 0; k < N; k++) {
+
+            centre[k] = (lower[k] + upper[k]) / static_cast<T>(2);
+            halfWidth[k] = (upper[k] - lower[k]) / static_cast<T>(2);
+        }
+
+        // Max-heap of regions by error estimate
+        std::vector<Region> regions {cubature::genzMalik<V>(function, centre, halfWidth)};
+
+        QuadratureResult<V> result;
+        result.evaluations = pointsPerRegion;
+
+        auto batchSize = options.execution == Execution::Parallel ? quadrature::parallelBatch : size_t{1};
+
+        while (true) {
+
+            result.value = V{};
+            result.error = 0.0;
+
+            for (const auto &region : regions) {
+
+                result.value += region.value;
+                result.error += region.error;
+            }
+
+            result.intervals = regions.size();
+
+            if (cubature::isSettled(result.value, result.error, options)) {
+
+                result.converged = true;
+                break;
+            }
+
+            auto remaining = (options.maxEvaluations - std::min(options.maxEvaluations, result.evaluations)) / (2 * pointsPerRegion);
+            auto count = std::min({batchSize, regions.size(), remaining});
+
+            if (count == 0) break;
+
+            std::vector<Region> worst;
+
+            for (size_t i = 0; i < count; i++) {
+
+                std::pop_heap(regions.begin(), regions.end(), compare);
+
+                worst.push_back(regions.back());
+                regions.pop_back();
+            }
+
+            std::vector<Region> halves(2 * count);
+
+            forEachIndex(2 * count, [&] (size_t i) {
+
+                const auto &parent = worst[i / 2];
+                auto axis = parent.roughestAxis;
+
+                auto childCentre = parent.centre;
+                auto childHalfWidth = parent.halfWidth;
+
+                childHalfWidth[axis] /= static_cast<T>(2);
+                childCentre[axis] += i % 2 == 0 ? -childHalfWidth[axis] : childHalfWidth[axis];
+
+                halves[i] = cubature::genzMalik<V>(function, childCentre, childHalfWidth);
+
+            }, options.execution);
+
+            result.evaluations += halves.size() * pointsPerRegion;
+
+            for (auto &half : halves) {
+
+                regions.push_back(std::move(half));
+                std::push_heap(regions.begin(), regions.end(), compare);
+            }
+        }
+
+        return result;
+    }
+
+    // Integrate over the box [lower, upper] by randomly shifted quasi-Monte Carlo sampling
+    template <typename F, typename T, size_t N>
+    auto quasiMonteCarlo(const F &function, const tvec<T, N> &lower, const tvec<T, N> &upper, const CubatureOptions &options = {}) {
+
+        using V = typename std::decay<decltype(function(lower))>::type;
+
+        using quadrature::scale;
+        using quadrature::norm;
+
+        auto replicates = std::max(options.replicates, size_t{2});
+        auto batchSize = std::max(options.batchSize, size_t{1});
+
+        // One random shift per replicate, applied modulo 1
+        std::mt19937_64 generator(options.seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        std::vector<std::array<double, N>> shifts(replicates);
+
+        for (auto &shift : shifts) {
+
+            for (auto &component : shift) {
+
+                component = uniform(generator);
+            }
+        }
+
+        auto volume = 1.0;
+
+        for (size_t k = 0; k < N; k++) {
+
+            volume *= static_cast<double>(upper[k] - lower[k]);
+        }
+
+        std::vector<V> sums(replicates);
+
+        QuadratureResult<V> result;
+
+        size_t points = 0;
+
+        while (result.evaluations + batchSize * replicates <= options.maxEvaluations) {
+
+            std::vector<V> samples(batchSize * replicates);
+
+            forEachIndex(samples.size(), [&] (size_t i) {
+
+                auto index = points + i / replicates;
+                const auto &shift = shifts[i % replicates];
+
+                auto unit = options.sequence == LowDiscrepancy::Sobol ? sobol<double, N>(index) : halton<double, N>(index);
+
+                auto point = lower;
+
+                for (size_t k = 0; k < N; k++) {
+
+                    auto shifted = unit[k] + shift[k];
+                    shifted -= std::floor(shifted);
+
+                    point[k] = lower[k] + static_cast<T>(shifted * static_cast<double>(upper[k] - lower[k]));
+                }
+
+                samples[i] = V(function(point));
+
+            }, options.execution);
+
+            // Accumulate in index order so the result doesn't depend on scheduling
+            for (size_t i = 0; i < samples.size(); i++) {
+
+                sums[i % replicates] += samples[i];
+            }
+
+            points += batchSize;
+            result.evaluations += samples.size();
+
+            // Mean and standard error over the replicate estimates
+            std::vector<V> estimates(replicates);
+
+            result.value = V{};
+
+            for (size_t r = 0; r < replicates; r++) {
+
+                estimates[r] = scale(sums[r], volume / static_cast<double>(points));
+                result.value += estimates[r];
+            }
+
+            result.value = scale(result.value, 1.0 / static_cast<double>(replicates));
+
+            auto variance = 0.0;
+
+            for (const auto &estimate : estimates) {
+
+                auto deviation = norm(estimate - result.value);
+                variance += deviation * deviation;
+            }
+
+            result.error = std::sqrt(variance / static_cast<double>(replicates * (replicates - 1)));
+
+            if (cubature::isSettled(result.value, result.error, options)) {
+
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef mth_fft_h__
+#define mth_fft_h__
+
+/* <mth/fft.h> - fast fourier transform header
+ *      Defines an in-place radix-2 fast fourier transform of complex
+ *      arrays, and convolution of coefficient arrays using it. Short
+ *      convolutions are done directly, since the transform only pays
+ *      off for longer inputs. Errors of the transformed convolution are
+ *      relative to the largest coefficients, so coefficients much smaller
+ *      than the largest lose relative precision.
+ */
+
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+
+namespace mth {
+
+    // Transform values in place to sum_k values[k] exp(-2 pi i jk / n), or back again if inverse is set
+    // The inverse includes the factor 1 / n, so it undoes the forward transform
+    // Throws std::invalid_argument if the size isn't a power of two
+    void fft(std::vector<comp> &values, bool inverse = false);
+
+    // Returns the coefficients of the product of the polynomials with the given coefficients
+    std::vector<comp> convolve(const std::vector<comp> &lhs, const std::vector<comp> &rhs);
+}
+
+#endif
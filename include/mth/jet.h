@@ -0,0 +1,433 @@
+#ifndef mth_jet_h__
+#define mth_jet_h__
+
+/* <mth/jet.h> - jet header
+ *      This includes the tjet template class representing a power series
+ *      of arbitrary scalar type truncated after z^N, as used in Taylor mode
+ *      automatic differentiation. Arithmetic and the functions mth::exp,
+ *      mth::log, mth::sqrt, mth::sin and mth::cos propagate all N + 1
+ *      coefficients through recurrences, so evaluating a function on
+ *      tjet<T, N>::variable(x) yields every derivative up to order N at x
+ *      from a single evaluation, with no finite differences.
+ */
+
+#include <array>
+#include <cmath>
+#include <iostream>
+
+#include <mth/mth.h>
+
+// comp.h needs tvec complete for the polar forms behind mth::log and mth::sqrt on complex jets
+#include <mth/vec.h>
+#include <mth/comp.h>
+
+namespace mth {
+
+    // Power series with scalar type T truncated after z^N
+
+    template <typename T, size_t N>
+    class tjet {
+
+    private:
+
+        // coeffs[k] is the coefficient of z^k, so the kth derivative divided by k!
+        std::array<T, N + 1> coeffs;
+
+    public:
+
+        // Initialize to zero
+        constexpr tjet() noexcept
+            :coeffs{} {}
+
+        // Initialize as a constant
+        constexpr tjet(const T &constant) noexcept
+            :coeffs{} {
+
+            coeffs[0] = constant;
+        }
+
+        constexpr tjet(const std::array<T, N + 1> &coeffs) noexcept
+            :coeffs(coeffs) {}
+
+        // Create the jet of the identity at a point, to differentiate with respect to it
+        static constexpr tjet<T, N> variable(const T &point) noexcept {
+
+            tjet<T, N> result(point);
+
+            if constexpr (N > 0) result.coeffs[1] = static_cast<T>(1);
+
+            return result;
+        }
+
+        constexpr size_t size() const noexcept {
+
+            return N + 1;
+        }
+
+        constexpr T &operator[](size_t index) noexcept {
+
+            return coeffs[index];
+        }
+
+        constexpr const T &operator[](size_t index) const noexcept {
+
+            return coeffs[index];
+        }
+
+        constexpr const T &value() const noexcept {
+
+            return coeffs[0];
+        }
+
+        // Returns the derivative of the given order, i.e. the coefficient times order!
+        constexpr T derivative(size_t order) const noexcept {
+
+            auto result = coeffs[order];
+
+            for (size_t k = 2; k <= order; k++) {
+
+                result *= static_cast<T>(k);
+            }
+
+            return result;
+        }
+
+        constexpr tjet<T, N> &operator+=(const tjet<T, N> &rhs) noexcept {
+
+            for (size_t k = 0; k <= N; k++) {
+
+                coeffs[k] += rhs[k];
+            }
+
+            return *this;
+        }
+
+        constexpr tjet<T, N> &operator-=(const tjet<T, N> &rhs) noexcept {
+
+            for (size_t k = 0; k <= N; k++) {
+
+                coeffs[k] -= rhs[k];
+            }
+
+            return *this;
+        }
+
+        // Cauchy product, dropping terms past z^N
+        constexpr tjet<T, N> &operator*=(const tjet<T, N> &rhs) noexcept {
+
+            // Go from the top down so each coefficient is only overwritten once nothing else needs it
+            for (auto k = N + 1; k-- > 0;) {
+
+                auto sum = static_cast<T>(0);
+
+                for (size_t j = 0; j <= k; j++) {
+
+                    sum += coeffs[j] * rhs[k - j];
+                }
+
+                coeffs[k] = sum;
+            }
+
+            return *this;
+        }
+
+        // Solves rhs * result = *this one coefficient at a time
+        constexpr tjet<T, N> &operator/=(const tjet<T, N> &rhs) noexcept {
+
+            for (size_t k = 0; k <= N; k++) {
+
+                for (size_t j = 1; j <= k; j++) {
+
+                    coeffs[k] -= rhs[j] * coeffs[k - j];
+                }
+
+                coeffs[k] /= rhs[0];
+            }
+
+            return *this;
+        }
+
+        constexpr tjet<T, N> &operator+=(const T &rhs) noexcept {
+
+            coeffs[0] += rhs;
+
+            return *this;
+        }
+
+        constexpr tjet<T, N> &operator-=(const T &rhs) noexcept {
+
+            coeffs[0] -= rhs;
+
+            return *this;
+        }
+
+        constexpr tjet<T, N> &operator*=(const T &rhs) noexcept {
+
+            for (auto &coeff : coeffs) coeff *= rhs;
+
+            return *this;
+        }
+
+        constexpr tjet<T, N> &operator/=(const T &rhs) noexcept {
+
+            for (auto &coeff : coeffs) coeff /= rhs;
+
+            return *this;
+        }
+    };
+
+    template <size_t N>
+    using jet = tjet<double, N>;
+
+    template <size_t N>
+    using cjet = tjet<comp, N>;
+
+    // Arithmetic operators
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator+(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result += rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator+(const tjet<T, N> &lhs, const T &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result += rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator+(const T &lhs, const tjet<T, N> &rhs) noexcept {
+
+        return rhs + lhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator-(const tjet<T, N> &rhs) noexcept {
+
+        auto result = rhs;
+
+        return result *= static_cast<T>(-1);
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator-(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result -= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator-(const tjet<T, N> &lhs, const T &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result -= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator-(const T &lhs, const tjet<T, N> &rhs) noexcept {
+
+        return -rhs + lhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator*(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result *= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator*(const tjet<T, N> &lhs, const T &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result *= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator*(const T &lhs, const tjet<T, N> &rhs) noexcept {
+
+        return rhs * lhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator/(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result /= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator/(const tjet<T, N> &lhs, const T &rhs) noexcept {
+
+        auto result = lhs;
+
+        return result /= rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> operator/(const T &lhs, const tjet<T, N> &rhs) noexcept {
+
+        return tjet<T, N>(lhs) / rhs;
+    }
+
+    template <typename T, size_t N>
+    constexpr bool operator==(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        for (size_t k = 0; k <= N; k++) {
+
+            if (!util::isEqual(lhs[k], rhs[k])) return false;
+        }
+
+        return true;
+    }
+
+    template <typename T, size_t N>
+    constexpr bool operator!=(const tjet<T, N> &lhs, const tjet<T, N> &rhs) noexcept {
+
+        return !(lhs == rhs);
+    }
+
+    template <typename T, size_t N>
+    std::ostream &operator<<(std::ostream &lhs, const tjet<T, N> &rhs) {
+
+        lhs << "[";
+
+        for (size_t k = 0; k < N; k++) {
+
+            lhs << rhs[k] << ", ";
+        }
+
+        return lhs << rhs[N] << "]";
+    }
+
+    // Functions of jets, each from the recurrence that its derivative satisfies
+
+    // b = exp(a) has b' = a' b
+    template <typename T, size_t N>
+    constexpr tjet<T, N> exp(const tjet<T, N> &x) noexcept {
+
+        using std::exp;
+
+        tjet<T, N> result(exp(x[0]));
+
+        for (size_t k = 1; k <= N; k++) {
+
+            auto sum = static_cast<T>(0);
+
+            for (size_t j = 1; j <= k; j++) {
+
+                sum += static_cast<T>(j) * x[j] * result[k - j];
+            }
+
+            result[k] = sum / static_cast<T>(k);
+        }
+
+        return result;
+    }
+
+    // b = log(a) has a b' = a'
+    template <typename T, size_t N>
+    constexpr tjet<T, N> log(const tjet<T, N> &x) noexcept {
+
+        using std::log;
+
+        tjet<T, N> result(log(x[0]));
+
+        for (size_t k = 1; k <= N; k++) {
+
+            auto sum = static_cast<T>(k) * x[k];
+
+            for (size_t j = 1; j < k; j++) {
+
+                sum -= static_cast<T>(j) * result[j] * x[k - j];
+            }
+
+            result[k] = sum / (static_cast<T>(k) * x[0]);
+        }
+
+        return result;
+    }
+
+    // b = sqrt(a) has b^2 = a
+    template <typename T, size_t N>
+    constexpr tjet<T, N> sqrt(const tjet<T, N> &x) noexcept {
+
+        using std::sqrt;
+
+        tjet<T, N> result(sqrt(x[0]));
+
+        for (size_t k = 1; k <= N; k++) {
+
+            auto sum = x[k];
+
+            for (size_t j = 1; j < k; j++) {
+
+                sum -= result[j] * result[k - j];
+            }
+
+            result[k] = sum / (static_cast<T>(2) * result[0]);
+        }
+
+        return result;
+    }
+
+    // s = sin(a) and c = cos(a) have s' = a' c and c' = -a' s, so are found together
+    template <typename T, size_t N>
+    constexpr void sinCos(const tjet<T, N> &x, tjet<T, N> &sine, tjet<T, N> &cosine) noexcept {
+
+        using std::sin;
+        using std::cos;
+
+        sine = tjet<T, N>(sin(x[0]));
+        cosine = tjet<T, N>(cos(x[0]));
+
+        for (size_t k = 1; k <= N; k++) {
+
+            auto sineSum = static_cast<T>(0);
+            auto cosineSum = static_cast<T>(0);
+
+            for (size_t j = 1; j <= k; j++) {
+
+                sineSum += static_cast<T>(j) * x[j] * cosine[k - j];
+                cosineSum -= static_cast<T>(j) * x[j] * sine[k - j];
+            }
+
+            sine[k] = sineSum / static_cast<T>(k);
+            cosine[k] = cosineSum / static_cast<T>(k);
+        }
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> sin(const tjet<T, N> &x) noexcept {
+
+        tjet<T, N> sine;
+        tjet<T, N> cosine;
+
+        sinCos(x, sine, cosine);
+
+        return sine;
+    }
+
+    template <typename T, size_t N>
+    constexpr tjet<T, N> cos(const tjet<T, N> &x) noexcept {
+
+        tjet<T, N> sine;
+        tjet<T, N> cosine;
+
+        sinCos(x, sine, cosine);
+
+        return cosine;
+    }
+}
+
+#endif
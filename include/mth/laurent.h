@@ -0,0 +1,88 @@
+#ifndef mth_laurent_h__
+#define mth_laurent_h__
+
+/* <mth/laurent.h> - Laurent series header
+ *      Defines the LaurentSeries class, a complex series about zero with
+ *      a pole of finite order: a finite principal part in negative powers
+ *      of z plus an analytic part held as a PowerSeries. This lets
+ *      functions with poles be expanded, multiplied and differentiated
+ *      without subtracting the poles by hand, and the residue is read
+ *      straight off the coefficients.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+#include <mth/powerseries.h>
+#include <mth/parallel.h>
+
+namespace mth {
+
+    class LaurentSeries;
+
+    LaurentSeries operator+(const LaurentSeries &lhs, const LaurentSeries &rhs);
+
+    LaurentSeries operator-(const LaurentSeries &rhs);
+    LaurentSeries operator-(const LaurentSeries &lhs, const LaurentSeries &rhs);
+
+    LaurentSeries operator*(const LaurentSeries &lhs, const comp &rhs);
+    LaurentSeries operator*(const comp &lhs, const LaurentSeries &rhs);
+    LaurentSeries operator*(const LaurentSeries &lhs, const LaurentSeries &rhs);
+
+    LaurentSeries operator/(const LaurentSeries &lhs, const comp &rhs);
+
+    class LaurentSeries {
+
+    private:
+
+        // principal[k] is the coefficient of z^-(k + 1)
+        std::vector<comp> principal;
+
+        PowerSeries analytic;
+
+    public:
+
+        // Default initializes to zero
+        LaurentSeries() = default;
+
+        // Create from the coefficients of z^-1, z^-2, ... in order, and the analytic part
+        LaurentSeries(std::vector<comp> principal, PowerSeries analytic);
+
+        // Create from a power series with no principal part
+        LaurentSeries(PowerSeries analytic);
+
+        // Create series(z) / z^poleOrder
+        static LaurentSeries divide(const PowerSeries &series, size_t poleOrder);
+
+        // Get the coefficient of z^index, for any index
+        comp getCoeff(std::ptrdiff_t index) const;
+
+        // Returns the coefficients of z^-1, z^-2, ... up to the pole order
+        const std::vector<comp> &getPrincipal() const;
+
+        const PowerSeries &getAnalytic() const;
+
+        // Returns the order of the pole at zero, or zero if there isn't one
+        size_t getPoleOrder() const;
+
+        // Returns the coefficient of z^-1
+        comp residue() const;
+
+        // Returns z^poleOrder times the series as a power series
+        PowerSeries regular() const;
+
+        // Returns the principal part plus the analytic part up to z^order evaluated at z
+        // Throws std::invalid_argument at zero if there is a pole
+        comp value(const comp &z, size_t order) const;
+
+        // Returns the truncations up to z^order evaluated at each point, reading the coefficients once
+        std::vector<comp> values(const std::vector<comp> &points, size_t order, Execution execution = Execution::Serial) const;
+    };
+
+    // Returns the termwise derivative
+    LaurentSeries differentiate(const LaurentSeries &series);
+}
+
+#endif
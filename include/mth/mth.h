@@ -37,8 +37,6 @@
 #include <limits>
 
 // TODO: Sequence wrapper class (e.g. for recursive sequences)
-// TODO: Rational functions
-// TODO: Laurent series
 // TODO: Better exception / debug info maybe
 
 namespace mth {
@@ -58,6 +56,7 @@ namespace mth {
     template <typename T>
     constexpr T e =   static_cast<T>(2.71828182845904523536028747135266249775724709369995957496696762772407663035);
 
+    // Returns n!, or infinity past 170! where doubles overflow; <mth/special.h> has log space versions
     double factorial(size_t n);
 
     // Global utility functions
@@ -8,35 +8,159 @@
  */
 
 #include <functional>
+#include <vector>
 
 #include <mth/mth.h>
 #include <mth/comp.h>
+#include <mth/parallel.h>
 
 // TODO: Limit of recursive sequence
 // TODO: Less naive methods
 
 namespace mth {
 
+    // Methods for accelerating the convergence of a series
+    enum class Acceleration {
+
+        // A single Shanks transform followed by polynomial extrapolation
+        Shanks,
+
+        // Wynn's epsilon algorithm, equivalent to iterated Shanks transforms
+        Wynn,
+
+        // Levin's u-transform, which also handles logarithmic convergence
+        Levin,
+
+        // Euler's transform with Van Wijngaarden's adaptive order, for alternating series
+        Euler,
+
+        // Euler for series whose terms alternate in sign, otherwise Shanks
+        Automatic
+    };
+
+    // Incrementally updated tableau of Wynn's epsilon algorithm
+    // Each partial sum adds one anti-diagonal of at most maxColumns entries
+    class WynnEpsilon {
+
+    private:
+
+        size_t maxColumns;
+        size_t count = 0;
+
+        // The latest anti-diagonal, indexed by column starting at epsilon_0
+        std::vector<comp> diagonal;
+
+        comp current;
+        comp previous;
+
+    public:
+
+        WynnEpsilon(size_t maxColumns = 24);
+
+        // Add the next partial sum
+        void push(const comp &partial);
+
+        // Returns the current estimate of the limit
+        comp estimate() const;
+
+        // Returns the difference between the last two estimates
+        double error() const;
+
+        // Returns the number of partial sums added
+        size_t size() const;
+    };
+
+    // Incrementally updated tableau of Levin's u-transform
+    // Each term adds one anti-diagonal of at most maxOrder + 1 entries
+    class LevinU {
+
+    private:
+
+        size_t maxOrder;
+        size_t count = 0;
+
+        // The latest anti-diagonals of the numerator and denominator recursions
+        std::vector<comp> numerators;
+        std::vector<comp> denominators;
+
+        comp current;
+        comp previous;
+
+    public:
+
+        LevinU(size_t maxOrder = 16);
+
+        // Add the next partial sum and the term that was added to reach it
+        void push(const comp &partial, const comp &term);
+
+        // Returns the current estimate of the limit
+        comp estimate() const;
+
+        // Returns the difference between the last two estimates
+        double error() const;
+
+        // Returns the number of partial sums added
+        size_t size() const;
+    };
+
+    // Incrementally applied Euler transform of an alternating series
+    // Terms are summed directly until the transformed differences shrink faster than the terms,
+    // after which each term raises the order of the transform applied to the tail
+    class EulerTransform {
+
+    private:
+
+        size_t count = 0;
+
+        // The latest row of averaged differences of the terms; the last entry is the highest order used
+        std::vector<comp> differences;
+
+        comp current;
+        comp previous;
+
+    public:
+
+        // Add the next term
+        void push(const comp &term);
+
+        // Returns the current estimate of the limit
+        comp estimate() const;
+
+        // Returns the difference between the last two estimates
+        double error() const;
+
+        // Returns the number of terms added
+        size_t size() const;
+    };
+
+    // Returns whether the terms from first up to first + count alternate in sign, as real multiples of each other
+    bool isAlternating(const std::function<comp(size_t)> &sequence, size_t first = 8, size_t count = 8);
+
+    // Limits evaluate their samples using the given execution policy
+    // With Execution::Parallel the function must be safe to call concurrently
+
     // Returns an approximation of the limit at infinity of a sequence
-    comp limit(const std::function<comp(size_t)> &sequence);
+    comp limit(const std::function<comp(size_t)> &sequence, Execution execution = Execution::Serial);
 
     // Returns an approximation of the limit at infinity of a series
-    comp seriesLimit(const std::function<comp(size_t)> &partialSum, const std::function<comp(size_t)> &sequence);
+    // Wynn, Levin and Euler only evaluate as many terms as needed to converge, ignoring partialSum
+    comp seriesLimit(const std::function<comp(size_t)> &partialSum, const std::function<comp(size_t)> &sequence,
+                     Acceleration method = Acceleration::Shanks);
 
     // Returns the limit of the sequence approaching from below (parallel with real axis)
-    comp lowerLimit(const std::function<comp(comp)> &function, const comp &input);
+    comp lowerLimit(const std::function<comp(comp)> &function, const comp &input, Execution execution = Execution::Serial);
 
     // Returns the limit of the sequence approaching from above (parallel with real axis)
-    comp upperLimit(const std::function<comp(comp)> &function, const comp &input);
+    comp upperLimit(const std::function<comp(comp)> &function, const comp &input, Execution execution = Execution::Serial);
 
     // Defaults to lower limit
-    comp limit(const std::function<comp(comp)> &function, const comp &input);
+    comp limit(const std::function<comp(comp)> &function, const comp &input, Execution execution = Execution::Serial);
 
     // Returns the limit of the sequence function(n)
-    comp limitInfPos(const std::function<comp(comp)> &function);
+    comp limitInfPos(const std::function<comp(comp)> &function, Execution execution = Execution::Serial);
 
     // Returns the limit of the sequence function(-n)
-    comp limitInfNeg(const std::function<comp(comp)> &function);
+    comp limitInfNeg(const std::function<comp(comp)> &function, Execution execution = Execution::Serial);
 
     // Returns an approximation of the derivative using numeric::limit
     std::function<comp(comp)> differentiate(const std::function<comp(comp)> &function);
@@ -0,0 +1,74 @@
+#ifndef mth_parallel_h__
+#define mth_parallel_h__
+
+/* <mth/parallel.h> - parallel execution header
+ *      Defines the Execution policy used by numeric functions to choose
+ *      between serial and concurrent evaluation, and the ThreadPool class
+ *      that concurrent evaluation runs on. Functions evaluated in parallel
+ *      must be safe to call from multiple threads at once.
+ */
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <mth/mth.h>
+
+namespace mth {
+
+    // Execution policy for functions that evaluate independent samples
+    enum class Execution {
+
+        // Evaluate on the calling thread in order
+        Serial,
+
+        // Evaluate concurrently on ThreadPool::shared()
+        Parallel
+    };
+
+    // Fixed-size pool of worker threads
+    class ThreadPool {
+
+    private:
+
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+
+        std::mutex mutex;
+        std::condition_variable available;
+
+        bool stopping = false;
+
+        void work();
+
+    public:
+
+        // Initialize with a number of workers, defaulting to the hardware concurrency
+        explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+
+        // Waits for queued tasks to finish
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // Returns the number of worker threads
+        size_t size() const;
+
+        // Calls body(i) for each i < count, returning once all calls have finished
+        // The calling thread takes part, and calls from inside a worker run serially to avoid deadlock
+        // The first exception thrown by body is rethrown after all calls have finished
+        void parallelFor(size_t count, const std::function<void(size_t)> &body);
+
+        // Returns the pool shared by the library
+        static ThreadPool &shared();
+    };
+
+    // Calls body(i) for each i < count using the given execution policy
+    void forEachIndex(size_t count, const std::function<void(size_t)> &body, Execution execution);
+}
+
+#endif
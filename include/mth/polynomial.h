@@ -255,6 +255,17 @@ namespace mth {
 
     Polynomial differentiate(const Polynomial &polynomial);
     Polynomial integrate(const Polynomial &polynomial);
+
+    // Changes of variable
+
+    // Returns p(z + offset), re-centering the polynomial at offset
+    // Direct for low degrees, and divide and conquer over FFT multiplication for high degrees, costing O(n log^2 n)
+    // The fast path has errors relative to the largest intermediate coefficient, so it suits well scaled
+    // polynomials whose shifted coefficients don't span many orders of magnitude
+    Polynomial shift(const Polynomial &polynomial, const comp &offset);
+
+    // Returns p(factor * z)
+    Polynomial dilate(const Polynomial &polynomial, const comp &factor);
 }
 
 #endif
@@ -6,33 +6,85 @@
  *      This has methods for evaluating at points, finding partial sums
  *      and full sums. It can be created either from a generating function,
  *      a finite polynomial, or a recursive coefficient relation.
+ *      Coefficients are cached once generated, and arithmetic works on
+ *      truncations of the operands, so the first n coefficients of any
+ *      result only depend on the first n coefficients of its operands.
  */
 
 #include <functional>
+#include <memory>
+#include <vector>
 
 #include <mth/mth.h>
 #include <mth/comp.h>
 #include <mth/polynomial.h>
 #include <mth/series.h>
+#include <mth/parallel.h>
 
 namespace mth {
 
+    class PowerSeries;
+
+    PowerSeries operator+(const PowerSeries &lhs, const PowerSeries &rhs);
+
+    PowerSeries operator-(const PowerSeries &rhs);
+    PowerSeries operator-(const PowerSeries &lhs, const PowerSeries &rhs);
+
+    PowerSeries operator*(const PowerSeries &lhs, const comp &rhs);
+    PowerSeries operator*(const comp &lhs, const PowerSeries &rhs);
+    PowerSeries operator*(const PowerSeries &lhs, const PowerSeries &rhs);
+
+    PowerSeries operator/(const PowerSeries &lhs, const comp &rhs);
+
+    // Throws std::invalid_argument if rhs has a zero constant coefficient
+    PowerSeries operator/(const PowerSeries &lhs, const PowerSeries &rhs);
+
+    // Methods for estimating the radius of convergence from coefficients
+    enum class RadiusMethod {
+
+        // Ratios of consecutive coefficients |a_(n - 1) / a_n|
+        Ratio,
+
+        // The root test |a_n|^(-1 / n)
+        Root,
+
+        // Extrapolating the ratios linearly in 1 / n to n = infinity, which removes the leading
+        // correction from a power law singularity
+        DombSykes
+    };
+
+    // How many terms a truncated power series needs at a point
+    struct TruncationEstimate {
+
+        // Number of terms, so the truncation is up to z^(terms - 1)
+        size_t terms = 0;
+
+        double radius = 0.0;
+
+        // False if the point lies outside the estimated disc of convergence, or the estimate needs more than
+        // the allowed number of terms
+        bool converges = false;
+    };
+
     class PowerSeries {
 
     private:
 
-            std::function<comp(size_t)> generatingFunction = [] (size_t n) {
+            // Cache of generated coefficients, shared between copies
+            struct Coefficients;
 
-                return comp(0);
-            };
+            std::shared_ptr<Coefficients> coefficients;
 
             bool isTrivial = false;
             Polynomial trivialSeries;
 
+            // Create the series with a_n = ratio(n) a_(n - step), from step initial coefficients
+            static PowerSeries fromRatios(std::vector<comp> initial, std::function<comp(size_t)> ratio);
+
     public:
 
         // Default initializes to zero
-        PowerSeries() = default;
+        PowerSeries();
 
         // Initialize from a generating function
         PowerSeries(std::function<comp(size_t)> generatingFunction);
@@ -40,25 +92,121 @@ namespace mth {
         // Get the coefficient at an index
         comp getCoeff(size_t index) const;
 
-        // TODO: Transforms (i.e. x -> (x - a))
-        // TODO: Taylor series
-        
+        // Returns the first count coefficients
+        std::vector<comp> getCoeffs(size_t count) const;
+
+        // Returns the polynomial with the coefficients up to z^order
+        Polynomial truncate(size_t order) const;
+
+        // Returns an estimate of the radius of convergence from the first count coefficients
+        // Finite series, and coefficients decaying faster than geometrically, give infinity
+        double radius(size_t count = 64, RadiusMethod method = RadiusMethod::DombSykes) const;
+
+        // Estimate how many terms bring the error at z below tolerance, assuming the coefficients keep
+        // decaying at the rate of the estimated radius
+        TruncationEstimate termsFor(const comp &z, double tolerance, size_t count = 64, size_t maxTerms = 100000) const;
+
         // Returns the series evaluated at z
+        // Powers of z are tabulated as the terms are reached, so summing n terms costs O(n)
         Series series(const comp &z) const;
 
+        // Returns the truncation up to z^order evaluated at z by Horner's scheme
+        comp value(const comp &z, size_t order) const;
+
+        // Returns the truncation up to z^order evaluated at each point, reading the coefficients once
+        std::vector<comp> values(const std::vector<comp> &points, size_t order, Execution execution = Execution::Serial) const;
+
         // Create a finite power series from a polynomial
         // TODO: Have this as a cast constructor too maybe
         static PowerSeries finite(const Polynomial &equivalent);
 
-        // Create a power series from a recursive relation of the coefficients
-        // TODO: Include n as a parameter
+        // Create the Taylor series of f about centre, so coefficient k is that of z^k in f(centre + z)
+        // The first order coefficients come from the Cauchy integral formula, sampling f at a power of two
+        // number of points around the circle of a radius about centre and taking one FFT
+        // f must be analytic on a disc larger than the circle: aliasing errors grow like (radius / R)^(2 order) for
+        // a singularity at distance R, while rounding errors in coefficient k grow like radius^-k
+        static PowerSeries taylor(const std::function<comp(comp)> &f, const comp &centre, double radius, size_t order,
+                                  Execution execution = Execution::Serial);
+
+        // Series of common functions about zero
+        // Coefficients come from exact ratio recurrences written straight into the cache, so none need
+        // factorials and they stay accurate until they underflow
+
+        static PowerSeries exponential();
+        static PowerSeries sine();
+        static PowerSeries cosine();
+
+        // Returns the series of log(1 + z)
+        static PowerSeries logarithm();
+
+        static PowerSeries arctangent();
+
+        // Returns the series of (1 + z)^exponent, whose coefficients vanish past the exponent when it is natural
+        static PowerSeries binomial(const comp &exponent);
+
+        // Create a power series from a function returning its first count coefficients for any count
+        // Coefficients are requested in blocks that at least double in size, and only the new ones are kept
+        static PowerSeries fromTruncation(std::function<std::vector<comp>(size_t)> truncation);
+
+        // Create a power series from a recursive relation of the coefficients, as in Series::recursive
+        // Coefficients are memoized so reaching the nth costs n calls to recursion in total
+
+        // Coefficients follow a_n = recursion(a_(n - 1)) from a_0 = constant
         static PowerSeries recursive(std::function<comp(comp)> recursion, const comp &constant);
+
+        // Coefficients follow a_n = recursion(n, a_(n - 1)) from a_0 = constant
+        static PowerSeries recursive(std::function<comp(size_t, comp)> recursion, const comp &constant);
+
+        // Coefficients start with initial, then follow a_n = recursion(n, previous) where previous
+        // holds the last initial.size() coefficients in order
+        static PowerSeries recursive(std::function<comp(size_t, const std::vector<comp> &)> recursion, std::vector<comp> initial);
+
+        // Friend operators to allow access to trivial series
+
+        friend PowerSeries operator+(const PowerSeries &lhs, const PowerSeries &rhs);
+        friend PowerSeries operator*(const PowerSeries &lhs, const comp &rhs);
+        friend PowerSeries operator*(const PowerSeries &lhs, const PowerSeries &rhs);
     };
 
     // Differentiation and integration of power series
-    
+
     PowerSeries differentiate(const PowerSeries &series);
     PowerSeries integrate(const PowerSeries &series);
+
+    // Changes of variable
+
+    // Returns the truncation up to z^order re-centred at offset, as the polynomial p(z + offset)
+    // This approximates the series about offset as long as |offset| plus the distance used stays inside the
+    // disc of convergence
+    PowerSeries shift(const PowerSeries &series, const comp &offset, size_t order);
+
+    // Returns series(factor * z)
+    PowerSeries dilate(const PowerSeries &series, const comp &factor);
+
+    // Returns outer(inner(z))
+    // The first n coefficients take O(sqrt(n)) FFT products by the baby step giant step method, plus O(n^2)
+    // scalar work combining the powers of inner, rather than the O(n log n) of the elementary functions below
+    // Throws std::invalid_argument if inner has a non-zero constant coefficient, since the result would need every
+    // coefficient of outer
+    PowerSeries compose(const PowerSeries &outer, const PowerSeries &inner);
+
+    // Elementary functions of power series
+    // Past a few dozen coefficients these use Newton iteration over FFT multiplication, so the first n
+    // coefficients cost O(n log n); shorter truncations use direct O(n^2) recurrences
+
+    // Returns 1 / series
+    // Throws std::invalid_argument if the constant coefficient is zero
+    PowerSeries reciprocal(const PowerSeries &series);
+
+    PowerSeries exp(const PowerSeries &series);
+
+    // Returns the principal log
+    // Throws std::invalid_argument if the constant coefficient is zero
+    PowerSeries log(const PowerSeries &series);
+
+    // Returns the principal sqrt
+    // Throws std::invalid_argument if the constant coefficient is zero
+    PowerSeries sqrt(const PowerSeries &series);
 }
 
 #endif
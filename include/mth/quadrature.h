@@ -0,0 +1,308 @@
+#ifndef mth_quadrature_h__
+#define mth_quadrature_h__
+
+/* <mth/quadrature.h> - numeric integration header
+ *      Defines adaptive Gauss-Kronrod (G7K15) quadrature of arbitrary
+ *      callables over real intervals, straight complex contours and
+ *      circles. Values can be scalars, mth::comp or mth::tvec. The interval
+ *      is repeatedly bisected where the estimated error is largest until
+ *      the total error estimate meets the requested tolerance.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+#include <mth/vec.h>
+#include <mth/parallel.h>
+
+namespace mth {
+
+    // Stopping criteria and evaluation policy for adaptive quadrature
+    struct QuadratureOptions {
+
+        // Stop once the error estimate is at most max(absTolerance, relTolerance * |value|)
+        double absTolerance = 1e-10;
+        double relTolerance = 1e-10;
+
+        // Give up once the interval has been split into this many subintervals
+        size_t maxIntervals = 1000;
+
+        // With Execution::Parallel several subintervals are bisected and evaluated at once
+        Execution execution = Execution::Serial;
+    };
+
+    // Result of an adaptive quadrature
+    template <typename V>
+    struct QuadratureResult {
+
+        V value {};
+
+        // Estimated absolute error of value
+        double error = 0.0;
+
+        size_t evaluations = 0;
+        size_t intervals = 0;
+
+        bool converged = false;
+    };
+
+    namespace quadrature {
+
+        // Positive nodes of the 15 point Kronrod rule on [-1, 1], largest first; odd indices are the Gauss nodes
+        constexpr std::array<double, 8> kronrodNodes {
+
+            0.991455371120812639206854697526329,
+            0.949107912342758524526189684047851,
+            0.864864423359769072789712788640926,
+            0.741531185599394439863864773280788,
+            0.586087235467691130294144845693013,
+            0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245,
+            0.000000000000000000000000000000000
+        };
+
+        constexpr std::array<double, 8> kronrodWeights {
+
+            0.022935322010529224963732008058970,
+            0.063092092629978553290700663189204,
+            0.104790010322250183839876322541518,
+            0.140653259715525918745189590510238,
+            0.169004726639267902826583426598550,
+            0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649,
+            0.209482141084727828012999174891714
+        };
+
+        // Weights of the embedded 7 point Gauss rule at kronrodNodes[1], [3], [5] and [7]
+        constexpr std::array<double, 4> gaussWeights {
+
+            0.129484966168869693270611432679082,
+            0.279705391489276667901467771423780,
+            0.381830050505118944950369775488975,
+            0.417959183673469387755102040816327
+        };
+
+        // Number of subintervals bisected per round when evaluating in parallel
+        constexpr size_t parallelBatch = 16;
+
+        // Magnitudes used for error estimates
+
+        template <typename T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+        double norm(const T &value) {
+
+            return std::abs(static_cast<double>(value));
+        }
+
+        template <typename T>
+        double norm(const tcomp<T> &value) {
+
+            return value.abs();
+        }
+
+        template <typename T, size_t N>
+        double norm(const tvec<T, N> &value) {
+
+            auto result = 0.0;
+
+            for (const auto &element : value) {
+
+                auto n = norm(element);
+                result += n * n;
+            }
+
+            return std::sqrt(result);
+        }
+
+        // Scaling by a real weight, converted to the scalar type of the value
+
+        template <typename V>
+        V scale(const V &value, double weight) {
+
+            return value * static_cast<V>(weight);
+        }
+
+        template <typename T, size_t N>
+        tvec<T, N> scale(const tvec<T, N> &value, double weight) {
+
+            return value * static_cast<T>(weight);
+        }
+
+        // Scaling by a complex factor for contour integrals
+
+        template <typename T>
+        tcomp<T> scale(const tcomp<T> &value, const tcomp<T> &factor) {
+
+            return value * factor;
+        }
+
+        template <typename T, size_t N>
+        tvec<tcomp<T>, N> scale(const tvec<tcomp<T>, N> &value, const tcomp<T> &factor) {
+
+            return value * factor;
+        }
+
+        // A subinterval with its G7K15 estimate
+        template <typename V>
+        struct Segment {
+
+            double lower;
+            double upper;
+
+            V value;
+            double error;
+        };
+
+        // Apply the G7K15 rule to function over [lower, upper]
+        template <typename V, typename G>
+        Segment<V> kronrod(const G &function, double lower, double upper) {
+
+            auto centre = 0.5 * (lower + upper);
+            auto halfWidth = 0.5 * (upper - lower);
+
+            V centreValue = function(centre);
+
+            auto kronrodSum = scale(centreValue, kronrodWeights[7]);
+            auto gaussSum = scale(centreValue, gaussWeights[3]);
+
+            for (size_t i = 0; i < 7; i++) {
+
+                auto offset = halfWidth * kronrodNodes[i];
+
+                V pair = function(centre - offset);
+                pair += function(centre + offset);
+
+                kronrodSum += scale(pair, kronrodWeights[i]);
+
+                if (i % 2 == 1) gaussSum += scale(pair, gaussWeights[i / 2]);
+            }
+
+            auto value = scale(kronrodSum, halfWidth);
+            auto gaussValue = scale(gaussSum, halfWidth);
+
+            return Segment<V>{lower, upper, value, norm(value - gaussValue)};
+        }
+
+        // Adaptively integrate function over [lower, upper]
+        template <typename V, typename G>
+        QuadratureResult<V> adaptive(const G &function, double lower, double upper, const QuadratureOptions &options) {
+
+            constexpr size_t pointsPerSegment = 15;
+
+            auto compare = [] (const Segment<V> &lhs, const Segment<V> &rhs) { return lhs.error < rhs.error; };
+
+            // Max-heap of segments by error estimate
+            std::vector<Segment<V>> segments {kronrod<V>(function, lower, upper)};
+
+            QuadratureResult<V> result;
+            result.evaluations = pointsPerSegment;
+
+            auto batchSize = options.execution == Execution::Parallel ? parallelBatch : size_t{1};
+
+            while (true) {
+
+                // Sum in heap order; the sum is recomputed each round to avoid drift from repeated updates
+                result.value = V{};
+                result.error = 0.0;
+
+                for (const auto &segment : segments) {
+
+                    result.value += segment.value;
+                    result.error += segment.error;
+                }
+
+                result.intervals = segments.size();
+
+                if (result.error <= std::max(options.absTolerance, options.relTolerance * norm(result.value))) {
+
+                    result.converged = true;
+                    break;
+                }
+
+                if (segments.size() >= options.maxIntervals) break;
+
+                auto count = std::min({batchSize, segments.size(), options.maxIntervals - segments.size()});
+
+                std::vector<Segment<V>> worst;
+
+                for (size_t i = 0; i < count; i++) {
+
+                    std::pop_heap(segments.begin(), segments.end(), compare);
+
+                    worst.push_back(segments.back());
+                    segments.pop_back();
+                }
+
+                std::vector<Segment<V>> halves(2 * count);
+
+                forEachIndex(2 * count, [&] (size_t i) {
+
+                    const auto &parent = worst[i / 2];
+                    auto middle = 0.5 * (parent.lower + parent.upper);
+
+                    halves[i] = i % 2 == 0 ? kronrod<V>(function, parent.lower, middle)
+                                           : kronrod<V>(function, middle, parent.upper);
+
+                }, options.execution);
+
+                result.evaluations += halves.size() * pointsPerSegment;
+
+                for (auto &half : halves) {
+
+                    segments.push_back(std::move(half));
+                    std::push_heap(segments.begin(), segments.end(), compare);
+                }
+            }
+
+            return result;
+        }
+    }
+
+    // Integrate a function of a real variable over [lower, upper]
+    template <typename F>
+    auto integrate(const F &function, double lower, double upper, const QuadratureOptions &options = {}) {
+
+        using V = typename std::decay<decltype(function(lower))>::type;
+
+        return quadrature::adaptive<V>(function, lower, upper, options);
+    }
+
+    // Integrate a complex function along the straight contour from start to end
+    template <typename F>
+    auto integrateLine(const F &function, const comp &start, const comp &end, const QuadratureOptions &options = {}) {
+
+        using V = typename std::decay<decltype(function(start))>::type;
+
+        auto direction = end - start;
+
+        auto parametrized = [&] (double t) {
+
+            return quadrature::scale(V(function(start + t * direction)), direction);
+        };
+
+        return quadrature::adaptive<V>(parametrized, 0.0, 1.0, options);
+    }
+
+    // Integrate a complex function anticlockwise around the circle of a radius about centre
+    template <typename F>
+    auto integrateCircle(const F &function, const comp &centre, double radius, const QuadratureOptions &options = {}) {
+
+        using V = typename std::decay<decltype(function(centre))>::type;
+
+        auto parametrized = [&] (double theta) {
+
+            auto offset = comp::fromPolar(radius, theta);
+
+            // dz = i * offset * dtheta
+            return quadrature::scale(V(function(centre + offset)), i<double> * offset);
+        };
+
+        return quadrature::adaptive<V>(parametrized, 0.0, tau<double>, options);
+    }
+}
+
+#endif
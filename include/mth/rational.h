@@ -0,0 +1,81 @@
+#ifndef mth_rational_h__
+#define mth_rational_h__
+
+/* <mth/rational.h> - rational function header
+ *      Defines the RationalFunction class, a quotient of two complex
+ *      polynomials, with field arithmetic and evaluation by Horner's
+ *      scheme. Rational functions can also be created as Pade
+ *      approximants of a power series, which often stay accurate far
+ *      outside the region where the series itself converges quickly.
+ */
+
+#include <functional>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+#include <mth/polynomial.h>
+#include <mth/powerseries.h>
+
+namespace mth {
+
+    class RationalFunction;
+
+    RationalFunction operator+(const RationalFunction &lhs, const RationalFunction &rhs);
+
+    RationalFunction operator-(const RationalFunction &rhs);
+    RationalFunction operator-(const RationalFunction &lhs, const RationalFunction &rhs);
+
+    RationalFunction operator*(const RationalFunction &lhs, const comp &rhs);
+    RationalFunction operator*(const comp &lhs, const RationalFunction &rhs);
+    RationalFunction operator*(const RationalFunction &lhs, const RationalFunction &rhs);
+
+    RationalFunction operator/(const RationalFunction &lhs, const comp &rhs);
+
+    // Throws std::invalid_argument if rhs is zero
+    RationalFunction operator/(const RationalFunction &lhs, const RationalFunction &rhs);
+
+    class RationalFunction {
+
+    private:
+
+        Polynomial numerator;
+        Polynomial denominator = Polynomial::fromCoeffs(1);
+
+        // Degrees are found once, since evaluation needs them every time
+        PolynomialDegree numeratorDegree = PolynomialDegree::infinite();
+        PolynomialDegree denominatorDegree = 0;
+
+    public:
+
+        // Default initializes to zero
+        RationalFunction() = default;
+
+        // Create as numerator / denominator
+        // Throws std::invalid_argument if the denominator is zero
+        RationalFunction(Polynomial numerator, Polynomial denominator = Polynomial::fromCoeffs(1));
+
+        const Polynomial &getNumerator() const;
+        const Polynomial &getDenominator() const;
+
+        // Evaluate at a point
+        // Outside the unit disc both polynomials are evaluated in 1 / z, so large z doesn't overflow
+        comp value(const comp &z) const;
+
+        // Call as a complex function
+        comp operator()(const comp &z) const;
+
+        // Convert to a complex function
+        operator std::function<comp(comp)>() const;
+
+        // Create the [numeratorDegree / denominatorDegree] Pade approximant of a series, whose expansion
+        // matches the first numeratorDegree + denominatorDegree + 1 coefficients
+        // The denominator solves a Toeplitz system by Levinson recursion in O(M^2), falling back to Gaussian
+        // elimination when a leading minor vanishes; degenerate systems set the free coefficients to zero
+        static RationalFunction pade(const PowerSeries &series, size_t numeratorDegree, size_t denominatorDegree);
+    };
+
+    // Returns the derivative by the quotient rule
+    RationalFunction differentiate(const RationalFunction &function);
+}
+
+#endif
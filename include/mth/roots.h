@@ -0,0 +1,433 @@
+#ifndef mth_roots_h__
+#define mth_roots_h__
+
+/* <mth/roots.h> - root finding header
+ *      Defines iterative methods to find roots of arbitrary functions:
+ *      Newton's method, the secant method and Muller's method on complex
+ *      functions, and Brent's method on bracketed real functions. Newton's
+ *      method can take its derivative analytically, from jets by automatic
+ *      differentiation, or numerically as a last resort. Each
+ *      accepts any callable (including std::function) and reports the
+ *      number of iterations and function evaluations it used.
+ */
+
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+#include <mth/jet.h>
+#include <mth/numeric.h>
+
+namespace mth {
+
+    // Stopping criteria for iterative root finding
+    struct RootOptions {
+
+        // Stop once a step is smaller than tolerance * max(1, |root|)
+        double tolerance = 1e-12;
+
+        // Stop once |f(root)| is at most this
+        double residual = 0.0;
+
+        // Give up after this many iterations
+        size_t maxIterations = 100;
+    };
+
+    // Result of an iterative root search
+    template <typename T>
+    struct RootResult {
+
+        T root = 0;
+
+        // The function evaluated at root
+        T value = 0;
+
+        size_t iterations = 0;
+        size_t evaluations = 0;
+
+        bool converged = false;
+    };
+
+    namespace roots {
+
+        // Check whether a step or residual satisfies the stopping criteria
+        template <typename T>
+        bool isSettled(const T &step, const T &root, const T &value, const RootOptions &options) {
+
+            using std::abs;
+            using mth::abs;
+
+            auto scale = abs(root) > 1.0 ? abs(root) : 1.0;
+
+            return abs(step) <= options.tolerance * scale || abs(value) <= options.residual;
+        }
+    }
+
+    // Newton's method using an analytic derivative
+    template <typename F, typename D>
+    RootResult<comp> newton(const F &function, const D &derivative, const comp &guess, const RootOptions &options = {}) {
+
+        RootResult<comp> result;
+
+        result.root = guess;
+        result.value = function(guess);
+        result.evaluations = 1;
+
+        while (result.iterations < options.maxIterations) {
+
+            if (util::isZero(result.value.abs())) {
+
+                result.converged = true;
+                break;
+            }
+
+            comp slope = derivative(result.root);
+            result.evaluations++;
+
+            // A stationary point gives no direction to step in
+            if (util::isZero(slope.abs())) break;
+
+            auto step = result.value / slope;
+
+            result.root -= step;
+            result.value = function(result.root);
+            result.evaluations++;
+            result.iterations++;
+
+            if (roots::isSettled(step, result.root, result.value, options)) {
+
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    // Newton's method with the derivative by automatic differentiation
+    // function must accept and return cjet<1>, and each evaluation gives both the value and the slope
+    template <typename F>
+    RootResult<comp> newtonJet(const F &function, const comp &guess, const RootOptions &options = {}) {
+
+        RootResult<comp> result;
+
+        auto evaluate = [&] (const comp &z) {
+
+            cjet<1> value = function(cjet<1>::variable(z));
+            result.evaluations++;
+
+            return value;
+        };
+
+        auto jet = evaluate(guess);
+
+        result.root = guess;
+        result.value = jet.value();
+
+        while (result.iterations < options.maxIterations) {
+
+            if (util::isZero(result.value.abs())) {
+
+                result.converged = true;
+                break;
+            }
+
+            auto slope = jet[1];
+
+            // A stationary point gives no direction to step in
+            if (util::isZero(slope.abs())) break;
+
+            auto step = result.value / slope;
+
+            result.root -= step;
+
+            jet = evaluate(result.root);
+            result.value = jet.value();
+            result.iterations++;
+
+            if (roots::isSettled(step, result.root, result.value, options)) {
+
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    // Newton's method using a numeric derivative from mth::differentiate
+    // Prefer newtonJet when the function can be evaluated on jets
+    // Each derivative costs many evaluations, which are included in the count
+    template <typename F>
+    RootResult<comp> newton(const F &function, const comp &guess, const RootOptions &options = {}) {
+
+        size_t evaluations = 0;
+
+        std::function<comp(comp)> counted = [&] (comp z) {
+
+            evaluations++;
+            return static_cast<comp>(function(z));
+        };
+
+        auto derivative = differentiate(counted);
+
+        auto result = newton(counted, derivative, guess, options);
+
+        result.evaluations = evaluations;
+
+        return result;
+    }
+
+    // Secant method from two initial points
+    template <typename F>
+    RootResult<comp> secant(const F &function, const comp &first, const comp &second, const RootOptions &options = {}) {
+
+        RootResult<comp> result;
+
+        auto previous = first;
+        comp previousValue = function(first);
+
+        result.root = second;
+        result.value = function(second);
+        result.evaluations = 2;
+
+        while (result.iterations < options.maxIterations) {
+
+            if (util::isZero(result.value.abs())) {
+
+                result.converged = true;
+                break;
+            }
+
+            auto denom = result.value - previousValue;
+
+            // Equal values give a horizontal secant
+            if (util::isZero(denom.abs())) break;
+
+            auto step = result.value * (result.root - previous) / denom;
+
+            previous = result.root;
+            previousValue = result.value;
+
+            result.root -= step;
+            result.value = function(result.root);
+            result.evaluations++;
+            result.iterations++;
+
+            if (roots::isSettled(step, result.root, result.value, options)) {
+
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    // Muller's method from three initial points, which can reach complex roots from real starting points
+    template <typename F>
+    RootResult<comp> muller(const F &function, const comp &first, const comp &second, const comp &third, const RootOptions &options = {}) {
+
+        using mth::sqrt;
+
+        RootResult<comp> result;
+
+        auto x0 = first;
+        auto x1 = second;
+
+        comp f0 = function(x0);
+        comp f1 = function(x1);
+
+        result.root = third;
+        result.value = function(third);
+        result.evaluations = 3;
+
+        while (result.iterations < options.maxIterations) {
+
+            if (util::isZero(result.value.abs())) {
+
+                result.converged = true;
+                break;
+            }
+
+            auto x2 = result.root;
+            auto f2 = result.value;
+
+            auto h1 = x1 - x0;
+            auto h2 = x2 - x1;
+
+            // Coincident points leave the interpolating parabola undefined
+            if (util::isZero(h1.abs()) || util::isZero(h2.abs()) || util::isZero((h1 + h2).abs())) break;
+
+            auto d1 = (f1 - f0) / h1;
+            auto d2 = (f2 - f1) / h2;
+
+            auto a = (d2 - d1) / (h2 + h1);
+            auto b = a * h2 + d2;
+
+            auto discriminant = sqrt(b * b - 4.0 * f2 * a);
+
+            // Choose the sign giving the larger denominator, for the root of the parabola nearest x2
+            auto plus = b + discriminant;
+            auto minus = b - discriminant;
+            auto denom = plus.abs() > minus.abs() ? plus : minus;
+
+            if (util::isZero(denom.abs())) break;
+
+            auto step = 2.0 * f2 / denom;
+
+            x0 = x1;
+            f0 = f1;
+            x1 = x2;
+            f1 = f2;
+
+            result.root = x2 - step;
+            result.value = function(result.root);
+            result.evaluations++;
+            result.iterations++;
+
+            if (roots::isSettled(step, result.root, result.value, options)) {
+
+                result.converged = true;
+                break;
+            }
+        }
+
+        return result;
+    }
+
+    // Muller's method from a single guess, starting with points either side of it
+    template <typename F>
+    RootResult<comp> muller(const F &function, const comp &guess, const RootOptions &options = {}) {
+
+        auto offset = comp{0.5};
+
+        return muller(function, guess - offset, guess + offset, guess, options);
+    }
+
+    // Brent's method on a real function with a sign change between lower and upper
+    // Throws std::invalid_argument if the interval doesn't bracket a root
+    template <typename F>
+    RootResult<double> brent(const F &function, double lower, double upper, const RootOptions &options = {}) {
+
+        using std::abs;
+        using std::swap;
+
+        RootResult<double> result;
+
+        auto a = lower;
+        auto b = upper;
+
+        double fa = function(a);
+        double fb = function(b);
+
+        result.evaluations = 2;
+
+        if ((fa > 0 && fb > 0) || (fa < 0 && fb < 0)) {
+
+            throw std::invalid_argument("mth::exception: brent requires an interval bracketing a root");
+        }
+
+        // Keep b as the best estimate and c as the other end of the bracket
+        auto c = a;
+        auto fc = fa;
+
+        auto d = b - a;
+        auto e = d;
+
+        while (result.iterations < options.maxIterations) {
+
+            if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0)) {
+
+                c = a;
+                fc = fa;
+                d = e = b - a;
+            }
+
+            if (abs(fc) < abs(fb)) {
+
+                a = b;
+                b = c;
+                c = a;
+
+                fa = fb;
+                fb = fc;
+                fc = fa;
+            }
+
+            auto bound = 2.0 * epsilon<double> * abs(b) + 0.5 * options.tolerance * (abs(b) > 1.0 ? abs(b) : 1.0);
+            auto midpoint = 0.5 * (c - b);
+
+            if (abs(midpoint) <= bound || fb == 0.0 || abs(fb) <= options.residual) {
+
+                result.converged = true;
+                break;
+            }
+
+            if (abs(e) >= bound && abs(fa) > abs(fb)) {
+
+                // Attempt inverse quadratic interpolation, or the secant step when only two points are distinct
+                auto s = fb / fa;
+
+                double p;
+                double q;
+
+                if (a == c) {
+
+                    p = 2.0 * midpoint * s;
+                    q = 1.0 - s;
+
+                } else {
+
+                    auto r = fb / fc;
+                    auto t = fa / fc;
+
+                    p = s * (2.0 * midpoint * t * (t - r) - (b - a) * (r - 1.0));
+                    q = (t - 1.0) * (r - 1.0) * (s - 1.0);
+                }
+
+                if (p > 0) q = -q;
+                p = abs(p);
+
+                // Accept the interpolation only if it stays inside the bracket and shrinks fast enough
+                auto limitA = 3.0 * midpoint * q - abs(bound * q);
+                auto limitB = abs(e * q);
+
+                if (2.0 * p < (limitA < limitB ? limitA : limitB)) {
+
+                    e = d;
+                    d = p / q;
+
+                } else {
+
+                    d = midpoint;
+                    e = d;
+                }
+
+            } else {
+
+                d = midpoint;
+                e = d;
+            }
+
+            a = b;
+            fa = fb;
+
+            b += abs(d) > bound ? d : (midpoint > 0 ? bound : -bound);
+            fb = function(b);
+
+            result.evaluations++;
+            result.iterations++;
+        }
+
+        result.root = b;
+        result.value = fb;
+
+        return result;
+    }
+}
+
+#endif
@@ -4,38 +4,189 @@
 // TODO: Comment
 
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include <mth/comp.h>
+#include <mth/numeric.h>
+#include <mth/parallel.h>
+#include <mth/summation.h>
+#include <mth/stream.h>
 
 namespace mth {
 
+    // Bounds on the memory used to cache values of a sequence
+    struct CachePolicy {
+
+        // Values are stored in chunks of this many
+        size_t chunkSize = 1024;
+
+        // Every value in the first denseChunks chunks is kept; past those only the last value of each chunk is
+        size_t denseChunks = 64;
+    };
+
+    // Result of summing a series until its tail is below a tolerance
+    struct LimitResult {
+
+        comp value;
+
+        // Number of terms summed, for instrumentation
+        size_t terms = 0;
+
+        // Bound on the magnitude of the tail left out of value
+        double error = 0.0;
+
+        bool converged = false;
+    };
+
+    class Series;
+
+    // Arithmetic on series acts termwise, except for the product of two series which is their Cauchy product
+    // Results reuse the operands' caches of terms, so terms of long chains of operations are each computed once
+
+    Series operator+(const Series &lhs, const Series &rhs);
+
+    Series operator-(const Series &rhs);
+    Series operator-(const Series &lhs, const Series &rhs);
+
+    Series operator*(const Series &lhs, const comp &rhs);
+    Series operator*(const comp &lhs, const Series &rhs);
+    Series operator*(const Series &lhs, const Series &rhs);
+
     class Series {
 
     private:
 
+        // Cache of partial sums, shared between copies since they have the same terms
+        // Safe to share between threads as long as the term function is
+        struct PartialCache;
+
         std::function<comp(size_t)> terms;
 
-        mutable size_t lastPartialIndex;
-        mutable comp lastPartial;
+        std::shared_ptr<PartialCache> cache;
 
         bool isTrivial = false;
         comp trivialSum;
 
+        // Returns a term, memoized in a cache shared between copies, for use as an operand of arithmetic
+        comp getCachedTerm(size_t index) const;
+
+        // Returns the sum of count terms from first, added in order with the series' summation strategy
+        // so the result doesn't depend on how chunks are scheduled
+        comp sumTerms(size_t first, size_t count) const;
+
     public:
 
+        // Friend operators to allow access to trivial sums and cached terms
+        friend Series operator+(const Series &lhs, const Series &rhs);
+        friend Series operator*(const Series &lhs, const comp &rhs);
+        friend Series operator*(const Series &lhs, const Series &rhs);
+
+        // Forward iterator over the terms of a series
+        class TermIterator {
+
+        private:
+
+            // Copies share the cache, and keep the terms alive while iterating
+            std::shared_ptr<const Series> series;
+            size_t index;
+
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = comp;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const comp *;
+            using reference = comp;
+
+            TermIterator(std::shared_ptr<const Series> series, size_t index);
+
+            comp operator*() const;
+
+            TermIterator &operator++();
+            TermIterator operator++(int);
+
+            bool operator==(const TermIterator &other) const;
+            bool operator!=(const TermIterator &other) const;
+        };
+
+        // Forward iterator over the partial sums of a series, adding one term per step with its summation strategy
+        class PartialIterator {
+
+        private:
+
+            std::shared_ptr<const Series> series;
+            size_t index;
+
+            // Sum of the terms before index, and of term index itself once it has been read
+            mutable Accumulator accumulator;
+            mutable bool hasCurrent = false;
+
+            void readCurrent() const;
+
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = comp;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const comp *;
+            using reference = comp;
+
+            PartialIterator(std::shared_ptr<const Series> series, size_t index);
+
+            comp operator*() const;
+
+            PartialIterator &operator++();
+            PartialIterator operator++(int);
+
+            bool operator==(const PartialIterator &other) const;
+            bool operator!=(const PartialIterator &other) const;
+        };
+
         // Default initializes to zero
         Series();
-        Series(std::function<comp(size_t)> terms);
+        Series(std::function<comp(size_t)> terms, CachePolicy policy = CachePolicy());
+
+        // Partial sums are accumulated with the given strategy, carrying any compensation across the whole cache
+        Series(std::function<comp(size_t)> terms, Summation summation, CachePolicy policy = CachePolicy());
 
         comp getTerm(size_t index) const;
 
+        Summation getSummation() const;
+
         // Returns the partial sum up to index inclusive
+        // Partial sums in the dense region of the cache are O(1) once reached, later ones cost at most
+        // one chunk of terms from the nearest cached chunk end
         comp getPartial(size_t index) const;
 
-        // Returns the numeric limit of the partial sums at z
-        comp getLimit() const;
+        // Returns the partial sum up to index inclusive, evaluating missing terms with the given policy
+        // With Execution::Parallel the terms are computed concurrently in chunks, so the term function must be
+        // safe to call from several threads; results match the serial overload exactly
+        comp getPartial(size_t index, Execution execution) const;
+
+        // Returns a range over the first count terms, or every term if count is omitted
+        Range<TermIterator> streamTerms(size_t count = std::numeric_limits<size_t>::max()) const;
+
+        // Returns a range over the first count partial sums, computed in a single pass without touching the cache
+        Range<PartialIterator> streamPartials(size_t count = std::numeric_limits<size_t>::max()) const;
 
-        static Series finite(std::vector<comp> terms);
+        // Returns the numeric limit of the partial sums, accelerated by the given method
+        // Acceleration::Automatic picks Euler's transform for alternating series and Shanks' for others
+        comp getLimit(Acceleration method = Acceleration::Shanks) const;
+
+        // Returns whether the terms alternate in sign, judged from a sample of early terms
+        bool isAlternating() const;
+
+        // Sum terms until the tail after them is bounded by tolerance, giving up after maxTerms terms
+        // tailBound(n) should bound |a_(n + 1) + a_(n + 2) + ...|; without it the tail is bounded once the
+        // recent terms alternate in sign with decreasing size, or shrink by a ratio below one that isn't growing
+        // The terms-based bounds assume that behaviour continues past the terms seen
+        LimitResult getLimit(double tolerance, std::function<double(size_t)> tailBound = nullptr,
+                             size_t maxTerms = 1000000) const;
+
+        static Series finite(std::vector<comp> terms, Summation summation = Summation::Naive);
 
         template <typename ...Q>
         static Series finite(Q... terms) {
@@ -60,8 +211,45 @@ namespace mth {
             return result;
         }
 
+        // Create a series from a recurrence on its terms
+        // Terms are memoized so reaching the nth term costs n calls to recursion in total
+
+        // Terms follow a_n = recursion(a_(n - 1)) from a_0 = init
         static Series recursive(std::function<comp(comp)> recursion, const comp &init);
+
+        // Terms follow a_n = recursion(n, a_(n - 1)) from a_0 = init
+        static Series recursive(std::function<comp(size_t, comp)> recursion, const comp &init);
+
+        // Terms start with initial, then follow a_n = recursion(n, previous) where previous
+        // holds the last initial.size() terms a_(n - k), ..., a_(n - 1) in order
+        static Series recursive(std::function<comp(size_t, const std::vector<comp> &)> recursion, std::vector<comp> initial);
     };
+
+#ifdef mth_COROUTINES
+
+    // Yield the terms of a series, which is copied so the generator can outlive it
+    inline Generator<comp> generateTerms(Series series) {
+
+        for (size_t index = 0;; index++) {
+
+            co_yield series.getTerm(index);
+        }
+    }
+
+    // Yield the running partial sums of a series
+    inline Generator<comp> generatePartials(Series series) {
+
+        Accumulator accumulator(series.getSummation());
+
+        for (size_t index = 0;; index++) {
+
+            accumulator.add(series.getTerm(index));
+
+            co_yield accumulator.total();
+        }
+    }
+
+#endif
 }
 
 #endif
@@ -0,0 +1,49 @@
+#ifndef mth_special_h__
+#define mth_special_h__
+
+/* <mth/special.h> - special functions header
+ *      Defines factorial-like functions that stay finite past the range
+ *      of mth::factorial by working in log space: log factorials, binomial
+ *      coefficients, and the complex gamma function and its log by the
+ *      Lanczos approximation. Each has an overload evaluating a vector
+ *      of arguments, serially or in parallel.
+ */
+
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/vec.h>
+#include <mth/comp.h>
+#include <mth/parallel.h>
+
+namespace mth {
+
+    // Returns log(n!), from the factorial table where it is finite
+    double logFactorial(size_t n);
+
+    // Returns log(n choose k), or -infinity if k > n
+    double logBinomial(size_t n, size_t k);
+
+    // Returns n choose k, or zero if k > n
+    // Computed exactly in integers while it fits in 64 bits, so it is correctly rounded there
+    // Past the factorial table it goes through log space, so only overflows when the result itself does
+    double binomial(size_t n, size_t k);
+
+    // Returns log(gamma(z)) by the Lanczos approximation, with a relative error around 1e-15
+    // The imaginary part varies continuously for Re(z) >= 1/2 rather than being reduced to the principal branch
+    // Throws std::invalid_argument at the poles z = 0, -1, -2, ...
+    comp lgamma(const comp &z);
+
+    // Returns gamma(z), using the reflection formula for Re(z) < 1/2
+    // Throws std::invalid_argument at the poles z = 0, -1, -2, ...
+    comp gamma(const comp &z);
+
+    // Overloads evaluating at each argument
+
+    std::vector<double> logFactorial(const std::vector<size_t> &n, Execution execution = Execution::Serial);
+
+    std::vector<comp> lgamma(const std::vector<comp> &z, Execution execution = Execution::Serial);
+    std::vector<comp> gamma(const std::vector<comp> &z, Execution execution = Execution::Serial);
+}
+
+#endif
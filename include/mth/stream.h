@@ -0,0 +1,354 @@
+#ifndef mth_stream_h__
+#define mth_stream_h__
+
+/* <mth/stream.h> - streaming header
+ *      Defines Range, a pair of iterators usable in range-based for
+ *      loops, and lazy transforms of ranges of complex values which
+ *      read their input once, front to back: Aitken's delta-squared
+ *      process and Euler's (binomial averaging) transform. Transforms
+ *      return ranges themselves, so they compose. With C++20 coroutines
+ *      Generator is also defined, for producing streams from coroutines.
+ */
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <exception>
+
+#define mth_COROUTINES 1
+
+#endif
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+
+namespace mth {
+
+    // A half-open pair of iterators [begin, end)
+    template <typename I>
+    class Range {
+
+    private:
+
+        I first;
+        I last;
+
+    public:
+
+        Range(I first, I last)
+            :first(std::move(first)), last(std::move(last)) {}
+
+        I begin() const {
+
+            return first;
+        }
+
+        I end() const {
+
+            return last;
+        }
+    };
+
+    // Yields s_n - (s_(n + 1) - s_n)^2 / (s_(n + 2) - 2s_(n + 1) + s_n) from each three consecutive values s_n
+    template <typename I>
+    class AitkenIterator {
+
+    private:
+
+        I current;
+        I last;
+
+        // The three latest values, oldest first
+        comp window[3];
+        bool ended = false;
+
+        // Shift the next value into the window, or mark the iterator ended if there isn't one
+        void read() {
+
+            if (current == last) {
+
+                ended = true;
+                return;
+            }
+
+            window[0] = window[1];
+            window[1] = window[2];
+            window[2] = *current;
+
+            ++current;
+        }
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = comp;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const comp *;
+        using reference = comp;
+
+        AitkenIterator(I first, I last)
+            :current(std::move(first)), last(std::move(last)) {
+
+            for (size_t i = 0; i < 3 && !ended; i++) read();
+        }
+
+        comp operator*() const {
+
+            auto denom = window[2] - 2.0 * window[1] + window[0];
+
+            // Once the differences vanish the sequence has settled
+            if (util::isZero(denom.abs())) return window[2];
+
+            auto step = window[2] - window[1];
+
+            return window[2] - step * step / denom;
+        }
+
+        AitkenIterator &operator++() {
+
+            read();
+            return *this;
+        }
+
+        AitkenIterator operator++(int) {
+
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const AitkenIterator &other) const {
+
+            return ended == other.ended && (ended || current == other.current);
+        }
+
+        bool operator!=(const AitkenIterator &other) const {
+
+            return !(*this == other);
+        }
+    };
+
+    // Yields the Euler means 2^-n * sum_k (n choose k) s_k of the values s_0, ..., s_n read so far
+    // Each value costs O(n) to average into the running difference table
+    template <typename I>
+    class EulerIterator {
+
+    private:
+
+        I current;
+        I last;
+
+        // Successive averages of the values read; the last entry is the current mean
+        std::vector<comp> averages;
+        bool ended = false;
+
+        void read() {
+
+            if (current == last) {
+
+                ended = true;
+                return;
+            }
+
+            // Average the new value with the previous row, one order at a time
+            auto next = static_cast<comp>(*current);
+
+            for (auto &average : averages) {
+
+                auto previous = average;
+
+                average = next;
+                next = 0.5 * (next + previous);
+            }
+
+            averages.push_back(next);
+
+            ++current;
+        }
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = comp;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const comp *;
+        using reference = comp;
+
+        EulerIterator(I first, I last)
+            :current(std::move(first)), last(std::move(last)) {
+
+            read();
+        }
+
+        comp operator*() const {
+
+            return averages.back();
+        }
+
+        EulerIterator &operator++() {
+
+            read();
+            return *this;
+        }
+
+        EulerIterator operator++(int) {
+
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const EulerIterator &other) const {
+
+            return ended == other.ended && (ended || current == other.current);
+        }
+
+        bool operator!=(const EulerIterator &other) const {
+
+            return !(*this == other);
+        }
+    };
+
+    // Apply Aitken's delta-squared process to a range of partial sums
+    // The range is read lazily, so it must outlive the result
+    template <typename R>
+    auto aitken(R &&range) {
+
+        using I = decltype(range.begin());
+
+        return Range<AitkenIterator<I>>(AitkenIterator<I>(range.begin(), range.end()),
+                                        AitkenIterator<I>(range.end(), range.end()));
+    }
+
+    // Apply Euler's transform to a range of partial sums, which speeds up slowly converging alternating series
+    template <typename R>
+    auto euler(R &&range) {
+
+        using I = decltype(range.begin());
+
+        return Range<EulerIterator<I>>(EulerIterator<I>(range.begin(), range.end()),
+                                       EulerIterator<I>(range.end(), range.end()));
+    }
+
+#ifdef mth_COROUTINES
+
+    // A coroutine yielding a lazy stream of values, consumed by iterating once
+    template <typename T>
+    class Generator {
+
+    public:
+
+        struct promise_type {
+
+            T value;
+            std::exception_ptr exception;
+
+            Generator get_return_object() {
+
+                return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            std::suspend_always yield_value(T yielded) {
+
+                value = std::move(yielded);
+                return {};
+            }
+
+            void return_void() {}
+
+            void unhandled_exception() {
+
+                exception = std::current_exception();
+            }
+        };
+
+        class Iterator {
+
+        private:
+
+            std::coroutine_handle<promise_type> handle;
+
+        public:
+
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T *;
+            using reference = const T &;
+
+            explicit Iterator(std::coroutine_handle<promise_type> handle = nullptr)
+                :handle(handle) {}
+
+            const T &operator*() const {
+
+                return handle.promise().value;
+            }
+
+            Iterator &operator++() {
+
+                handle.resume();
+
+                if (handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+
+                return *this;
+            }
+
+            bool operator==(const Iterator &other) const {
+
+                auto done = !handle || handle.done();
+                auto otherDone = !other.handle || other.handle.done();
+
+                return done && otherDone;
+            }
+
+            bool operator!=(const Iterator &other) const {
+
+                return !(*this == other);
+            }
+        };
+
+        explicit Generator(std::coroutine_handle<promise_type> handle)
+            :handle(handle) {}
+
+        Generator(Generator &&other) noexcept
+            :handle(std::exchange(other.handle, nullptr)) {}
+
+        Generator(const Generator &) = delete;
+        Generator &operator=(const Generator &) = delete;
+
+        ~Generator() {
+
+            if (handle) handle.destroy();
+        }
+
+        // Start the coroutine; may only be called once
+        Iterator begin() {
+
+            Iterator result(handle);
+
+            ++result;
+
+            return result;
+        }
+
+        Iterator end() {
+
+            return Iterator();
+        }
+
+    private:
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+#endif
+}
+
+#endif
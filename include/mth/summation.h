@@ -0,0 +1,71 @@
+#ifndef mth_summation_h__
+#define mth_summation_h__
+
+/* <mth/summation.h> - summation header
+ *      Defines strategies for adding many complex values: naive
+ *      left-to-right addition, Kahan-Babuska (Neumaier) compensated
+ *      summation and pairwise summation. Accumulator adds values one at
+ *      a time, while sum() adds an array, splitting the compensated and
+ *      pairwise strategies into independent lanes that the compiler can
+ *      vectorize. Naive sums stay in order, matching an Accumulator.
+ */
+
+#include <vector>
+
+#include <mth/mth.h>
+#include <mth/comp.h>
+
+namespace mth {
+
+    // Strategies for summing a sequence of values
+    enum class Summation {
+
+        // Add each value to a running total; error grows linearly with the count
+        Naive,
+
+        // Neumaier's variant of Kahan summation, tracking the rounding error of each addition
+        Kahan,
+
+        // Add values in a balanced tree; error grows with the log of the count
+        Pairwise
+    };
+
+    // Running sum of values added one at a time
+    class Accumulator {
+
+    private:
+
+        Summation method;
+
+        comp sum;
+
+        // Rounding error lost from sum, for Kahan
+        comp compensation;
+
+        // Sums of completed blocks of 2^k values, merged like a binary counter, for Pairwise
+        std::vector<comp> levels;
+        std::vector<size_t> levelSizes;
+
+        comp block;
+        size_t blockCount = 0;
+
+    public:
+
+        Accumulator(Summation method = Summation::Naive);
+
+        // Add the next value
+        void add(const comp &value);
+
+        // Returns the sum of the values added so far
+        comp total() const;
+
+        Summation getMethod() const;
+    };
+
+    // Returns the sum of count values using the given strategy
+    comp sum(const comp *values, size_t count, Summation method);
+
+    comp sum(const std::vector<comp> &values, Summation method);
+}
+
+#endif
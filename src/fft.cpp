@@ -0,0 +1,141 @@
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+#include <mth/mth.h>
+
+#include <mth/fft.h>
+
+// Below this many coefficients in the shorter input convolutions are computed directly
+constexpr size_t directConvolution = 32;
+
+// Returns exp(-2 pi i k / n) for k below n / 2, computed once per size and thread
+// Each is computed directly rather than by repeated multiplication, which would accumulate error
+const std::vector<mth::comp> &forwardTwiddles(size_t n) {
+
+    static thread_local std::vector<std::vector<mth::comp>> tables;
+
+    size_t level = 0;
+
+    while ((size_t{1} << level) < n) level++;
+
+    if (tables.size() <= level) tables.resize(level + 1);
+
+    auto &table = tables[level];
+
+    if (table.empty() && n > 1) {
+
+        table.resize(n / 2);
+
+        for (size_t k = 0; k < n / 2; k++) {
+
+            auto angle = -mth::tau<double> * static_cast<double>(k) / static_cast<double>(n);
+
+            table[k] = mth::comp::fromCartesian(std::cos(angle), std::sin(angle));
+        }
+    }
+
+    return table;
+}
+
+void mth::fft(std::vector<mth::comp> &values, bool inverse) {
+
+    auto n = values.size();
+
+    if (n == 0 || (n & (n - 1)) != 0) {
+
+        throw std::invalid_argument("mth::exception: fft requires a power of two size");
+    }
+
+    // Reorder into bit reversed index order so the butterflies can work in place
+    for (size_t i = 1, j = 0; i < n; i++) {
+
+        auto bit = n >> 1;
+
+        for (; j & bit; bit >>= 1) j ^= bit;
+
+        j ^= bit;
+
+        if (i < j) std::swap(values[i], values[j]);
+    }
+
+    const auto &twiddles = forwardTwiddles(n);
+
+    for (size_t length = 2; length <= n; length <<= 1) {
+
+        auto half = length / 2;
+        auto stride = n / length;
+
+        for (size_t start = 0; start < n; start += length) {
+
+            for (size_t k = 0; k < half; k++) {
+
+                auto even = values[start + k];
+                auto twiddle = twiddles[k * stride];
+
+                // The inverse transform rotates the other way
+                if (inverse) twiddle = twiddle.conjugate();
+
+                auto odd = values[start + k + half] * twiddle;
+
+                values[start + k] = even + odd;
+                values[start + k + half] = even - odd;
+            }
+        }
+    }
+
+    if (inverse) {
+
+        auto scale = 1.0 / static_cast<double>(n);
+
+        for (auto &value : values) value *= scale;
+    }
+}
+
+std::vector<mth::comp> mth::convolve(const std::vector<mth::comp> &lhs, const std::vector<mth::comp> &rhs) {
+
+    if (lhs.empty() || rhs.empty()) return {};
+
+    auto count = lhs.size() + rhs.size() - 1;
+
+    if (std::min(lhs.size(), rhs.size()) <= directConvolution) {
+
+        std::vector<comp> result(count);
+
+        for (size_t i = 0; i < lhs.size(); i++) {
+
+            for (size_t j = 0; j < rhs.size(); j++) {
+
+                result[i + j] += lhs[i] * rhs[j];
+            }
+        }
+
+        return result;
+    }
+
+    size_t size = 1;
+
+    while (size < count) size <<= 1;
+
+    std::vector<comp> lhsTransform(lhs);
+    std::vector<comp> rhsTransform(rhs);
+
+    lhsTransform.resize(size);
+    rhsTransform.resize(size);
+
+    fft(lhsTransform);
+    fft(rhsTransform);
+
+    for (size_t i = 0; i < size; i++) {
+
+        lhsTransform[i] *= rhsTransform[i];
+    }
+
+    fft(lhsTransform, true);
+
+    lhsTransform.resize(count);
+
+    return lhsTransform;
+}
@@ -0,0 +1,188 @@
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include <mth/mth.h>
+
+#include <mth/laurent.h>
+
+mth::LaurentSeries::LaurentSeries(std::vector<mth::comp> principal, mth::PowerSeries analytic)
+    :principal(std::move(principal)), analytic(std::move(analytic)) {
+
+    // Trailing zeros would overstate the pole order
+    while (!this->principal.empty() && util::isZero(this->principal.back())) {
+
+        this->principal.pop_back();
+    }
+}
+
+mth::LaurentSeries::LaurentSeries(mth::PowerSeries analytic)
+    :analytic(std::move(analytic)) {}
+
+mth::LaurentSeries mth::LaurentSeries::divide(const mth::PowerSeries &series, size_t poleOrder) {
+
+    if (poleOrder == 0) return LaurentSeries(series);
+
+    std::vector<comp> principal(poleOrder);
+
+    for (size_t k = 0; k < poleOrder; k++) {
+
+        principal[k] = series.getCoeff(poleOrder - 1 - k);
+    }
+
+    // Coefficients are read through series, so they share its cache
+    PowerSeries analytic([series, poleOrder] (size_t n) { return series.getCoeff(n + poleOrder); });
+
+    return LaurentSeries(std::move(principal), std::move(analytic));
+}
+
+mth::comp mth::LaurentSeries::getCoeff(std::ptrdiff_t index) const {
+
+    if (index >= 0) return analytic.getCoeff(static_cast<size_t>(index));
+
+    auto k = static_cast<size_t>(-index - 1);
+
+    return k < principal.size() ? principal[k] : comp{0};
+}
+
+const std::vector<mth::comp> &mth::LaurentSeries::getPrincipal() const {
+
+    return principal;
+}
+
+const mth::PowerSeries &mth::LaurentSeries::getAnalytic() const {
+
+    return analytic;
+}
+
+size_t mth::LaurentSeries::getPoleOrder() const {
+
+    return principal.size();
+}
+
+mth::comp mth::LaurentSeries::residue() const {
+
+    return getCoeff(-1);
+}
+
+mth::PowerSeries mth::LaurentSeries::regular() const {
+
+    if (principal.empty()) return analytic;
+
+    auto copy = *this;
+    auto poleOrder = principal.size();
+
+    return PowerSeries([copy, poleOrder] (size_t n) {
+
+        return copy.getCoeff(static_cast<std::ptrdiff_t>(n) - static_cast<std::ptrdiff_t>(poleOrder));
+    });
+}
+
+// Evaluate the principal part at z by Horner's scheme in 1 / z
+mth::comp principalValue(const std::vector<mth::comp> &principal, const mth::comp &z) {
+
+    if (principal.empty()) return mth::comp{0};
+
+    if (z == mth::comp{0}) throw std::invalid_argument("mth::exception: Laurent series evaluated at its pole");
+
+    auto w = 1.0 / z;
+    auto result = mth::comp{0};
+
+    for (auto coeff = principal.rbegin(); coeff != principal.rend(); coeff++) {
+
+        result = (result + *coeff) * w;
+    }
+
+    return result;
+}
+
+mth::comp mth::LaurentSeries::value(const mth::comp &z, size_t order) const {
+
+    return principalValue(principal, z) + analytic.value(z, order);
+}
+
+std::vector<mth::comp> mth::LaurentSeries::values(const std::vector<mth::comp> &points, size_t order, mth::Execution execution) const {
+
+    // Check for the pole before handing work to other threads
+    if (!principal.empty() && std::find(points.begin(), points.end(), comp{0}) != points.end()) {
+
+        throw std::invalid_argument("mth::exception: Laurent series evaluated at its pole");
+    }
+
+    auto result = analytic.values(points, order, execution);
+
+    forEachIndex(points.size(), [&] (size_t i) {
+
+        result[i] += principalValue(principal, points[i]);
+
+    }, execution);
+
+    return result;
+}
+
+mth::LaurentSeries mth::operator+(const mth::LaurentSeries &lhs, const mth::LaurentSeries &rhs) {
+
+    auto principal = lhs.getPrincipal();
+
+    principal.resize(std::max(principal.size(), rhs.getPrincipal().size()));
+
+    for (size_t k = 0; k < rhs.getPrincipal().size(); k++) {
+
+        principal[k] += rhs.getPrincipal()[k];
+    }
+
+    return LaurentSeries(std::move(principal), lhs.getAnalytic() + rhs.getAnalytic());
+}
+
+mth::LaurentSeries mth::operator-(const mth::LaurentSeries &rhs) {
+
+    return rhs * comp{-1};
+}
+
+mth::LaurentSeries mth::operator-(const mth::LaurentSeries &lhs, const mth::LaurentSeries &rhs) {
+
+    return lhs + (-rhs);
+}
+
+mth::LaurentSeries mth::operator*(const mth::LaurentSeries &lhs, const mth::comp &rhs) {
+
+    auto principal = lhs.getPrincipal();
+
+    for (auto &coeff : principal) coeff *= rhs;
+
+    return LaurentSeries(std::move(principal), lhs.getAnalytic() * rhs);
+}
+
+mth::LaurentSeries mth::operator*(const mth::comp &lhs, const mth::LaurentSeries &rhs) {
+
+    return rhs * lhs;
+}
+
+mth::LaurentSeries mth::operator*(const mth::LaurentSeries &lhs, const mth::LaurentSeries &rhs) {
+
+    // z^-p A times z^-q B is z^-(p + q) AB, which reuses truncated power series multiplication
+    return LaurentSeries::divide(lhs.regular() * rhs.regular(), lhs.getPoleOrder() + rhs.getPoleOrder());
+}
+
+mth::LaurentSeries mth::operator/(const mth::LaurentSeries &lhs, const mth::comp &rhs) {
+
+    return lhs * (1.0 / rhs);
+}
+
+mth::LaurentSeries mth::differentiate(const mth::LaurentSeries &series) {
+
+    auto &principal = series.getPrincipal();
+
+    if (principal.empty()) return LaurentSeries(differentiate(series.getAnalytic()));
+
+    // c z^-k differentiates to -k c z^-(k + 1), so nothing lands on z^-1
+    std::vector<comp> result(principal.size() + 1);
+
+    for (size_t k = 1; k <= principal.size(); k++) {
+
+        result[k] = -static_cast<double>(k) * principal[k - 1];
+    }
+
+    return LaurentSeries(std::move(result), differentiate(series.getAnalytic()));
+}
@@ -4,6 +4,7 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 
@@ -16,7 +17,17 @@
 #include <mth/polynomial.h>
 #include <mth/series.h>
 #include <mth/powerseries.h>
+#include <mth/rational.h>
+#include <mth/laurent.h>
+#include <mth/jet.h>
+#include <mth/special.h>
 #include <mth/numeric.h>
+#include <mth/parallel.h>
+#include <mth/roots.h>
+#include <mth/quadrature.h>
+#include <mth/cubature.h>
+#include <mth/summation.h>
+#include <mth/fft.h>
 
 #define mth_ASSERT_ZERO(a) ASSERT_TRUE(mth::util::isZero(a)) \
     << "Expected " << #a << " which is " << a << " to be zero" << std::endl;
@@ -293,6 +304,463 @@ TEST(SeriesTest, GetCloseLimitForE) {
     mth_ASSERT_LESS(diff, 0.000001);
 }
 
+TEST(SeriesTest, WynnLimitForPiUsesFewTerms) {
+
+    size_t evaluations = 0;
+
+    mth::Series piSeries([&] (size_t index) {
+
+        evaluations++;
+
+        using std::pow;
+        using std::sqrt;
+
+        mth::comp powThree = (mth::comp) pow(-3, index);
+        mth::comp odd = (mth::comp) (2 * index + 1);
+
+        return sqrt(12) * (odd * powThree).inverse();
+
+    });
+
+    double diff = (piSeries.getLimit(mth::Acceleration::Wynn) - mth::pi<mth::comp>).abs();
+
+    mth_ASSERT_LESS(diff, 0.000000000001);
+    mth_ASSERT_LESS(evaluations, 40);
+}
+
+TEST(SeriesTest, LevinLimitForLeibnizUsesFewTerms) {
+
+    size_t evaluations = 0;
+
+    mth::Series leibnizSeries([&] (size_t index) {
+
+        evaluations++;
+
+        auto sign = index % 2 == 0 ? 1.0 : -1.0;
+
+        return mth::comp(4.0 * sign / (2.0 * index + 1.0));
+
+    });
+
+    double diff = (leibnizSeries.getLimit(mth::Acceleration::Levin) - mth::pi<mth::comp>).abs();
+
+    mth_ASSERT_LESS(diff, 0.0000000001);
+    mth_ASSERT_LESS(evaluations, 40);
+}
+
+TEST(SeriesTest, LevinLimitForLogarithmicSeries) {
+
+    // Sum of 1 / n^2 converges logarithmically to pi^2 / 6
+    mth::Series zetaSeries([] (size_t index) {
+
+        auto n = static_cast<double>(index + 1);
+
+        return mth::comp(1.0 / (n * n));
+
+    });
+
+    auto expected = mth::pi<double> * mth::pi<double> / 6.0;
+    double diff = (zetaSeries.getLimit(mth::Acceleration::Levin) - mth::comp(expected)).abs();
+
+    mth_ASSERT_LESS(diff, 0.00000001);
+}
+
+TEST(SeriesTest, EulerLimitForLeibnizReachesDoublePrecision) {
+
+    size_t evaluations = 0;
+
+    mth::Series leibnizSeries([&] (size_t index) {
+
+        evaluations++;
+
+        auto sign = index % 2 == 0 ? 1.0 : -1.0;
+
+        return mth::comp(4.0 * sign / (2.0 * index + 1.0));
+
+    });
+
+    ASSERT_TRUE(leibnizSeries.isAlternating());
+
+    double diff = (leibnizSeries.getLimit(mth::Acceleration::Euler) - mth::pi<mth::comp>).abs();
+
+    mth_ASSERT_LESS(diff, 0.0000000000001);
+    mth_ASSERT_LESS(evaluations, size_t{100});
+}
+
+TEST(SeriesTest, AutomaticLimitDetectsAlternation) {
+
+    mth::Series alternatingHarmonic([] (size_t index) {
+
+        auto sign = index % 2 == 0 ? 1.0 : -1.0;
+
+        return mth::comp(sign / (index + 1.0));
+
+    });
+
+    mth::Series basel([] (size_t index) {
+
+        auto n = static_cast<double>(index + 1);
+
+        return mth::comp(1.0 / (n * n));
+
+    });
+
+    ASSERT_TRUE(alternatingHarmonic.isAlternating());
+    ASSERT_FALSE(basel.isAlternating());
+
+    double diff = (alternatingHarmonic.getLimit(mth::Acceleration::Automatic) - mth::comp(std::log(2.0))).abs();
+
+    mth_ASSERT_LESS(diff, 0.0000000000001);
+}
+
+TEST(SeriesTest, RepeatedPartialSumsAreCached) {
+
+    size_t evaluations = 0;
+
+    mth::Series series([&] (size_t index) {
+
+        evaluations++;
+
+        return mth::comp(static_cast<double>(index));
+    });
+
+    mth_ASSERT_EQ(series.getPartial(99), mth::comp(4950.0));
+    mth_ASSERT_EQ(series.getPartial(10), mth::comp(55.0));
+    mth_ASSERT_EQ(series.getPartial(99), mth::comp(4950.0));
+    mth_ASSERT_EQ(series.getPartial(100), mth::comp(5050.0));
+
+    mth_ASSERT_EQ(evaluations, size_t{101});
+}
+
+TEST(SeriesTest, PartialSumsPastDenseCacheAreCorrect) {
+
+    mth::CachePolicy policy;
+    policy.chunkSize = 4;
+    policy.denseChunks = 2;
+
+    size_t evaluations = 0;
+
+    mth::Series series([&] (size_t index) {
+
+        evaluations++;
+
+        return mth::comp(static_cast<double>(index));
+    }, policy);
+
+    for (size_t index : {30, 3, 17, 18, 12, 40, 7, 8, 31}) {
+
+        auto expected = static_cast<double>(index * (index + 1) / 2);
+
+        mth_ASSERT_EQ(series.getPartial(index), mth::comp(expected));
+    }
+
+    // Later partial sums only need terms from the nearest checkpoint
+    evaluations = 0;
+    series.getPartial(38);
+
+    mth_ASSERT_LESS(evaluations, policy.chunkSize);
+}
+
+TEST(SeriesTest, ConcurrentPartialSumsAgree) {
+
+    mth::CachePolicy policy;
+    policy.chunkSize = 16;
+    policy.denseChunks = 8;
+
+    std::atomic<size_t> evaluations {0};
+
+    mth::Series series([&] (size_t index) {
+
+        evaluations++;
+
+        return mth::comp(static_cast<double>(index));
+    }, policy);
+
+    mth::ThreadPool pool(4);
+
+    std::vector<mth::comp> results(400);
+
+    pool.parallelFor(results.size(), [&] (size_t i) {
+
+        results[i] = series.getPartial((i * 37) % results.size());
+    });
+
+    for (size_t i = 0; i < results.size(); i++) {
+
+        auto index = (i * 37) % results.size();
+        auto expected = static_cast<double>(index * (index + 1) / 2);
+
+        mth_ASSERT_EQ(results[i], mth::comp(expected));
+    }
+
+    // Each term in the dense region is computed once however many threads ask for it
+    evaluations = 0;
+    series.getPartial(policy.chunkSize * policy.denseChunks - 1);
+
+    mth_ASSERT_EQ(evaluations.load(), size_t{0});
+}
+
+TEST(SeriesTest, ParallelPartialSumsMatchSerial) {
+
+    mth::CachePolicy policy;
+    policy.chunkSize = 64;
+    policy.denseChunks = 4;
+
+    auto terms = [] (size_t index) {
+
+        auto n = static_cast<double>(index + 1);
+
+        return mth::comp(1.0 / (n * n));
+    };
+
+    mth::Series serial(terms, policy);
+    mth::Series parallel(terms, policy);
+
+    for (size_t index : {100, 20, 255, 256, 5000, 100000, 4000}) {
+
+        mth_ASSERT_EQ(parallel.getPartial(index, mth::Execution::Parallel), serial.getPartial(index));
+    }
+}
+
+TEST(SeriesTest, CompensatedPartialSumsAreAccurate) {
+
+    mth::CachePolicy policy;
+    policy.chunkSize = 1000;
+    policy.denseChunks = 10;
+
+    auto tenth = [] (size_t) { return mth::comp(0.1); };
+
+    mth::Series kahan(tenth, mth::Summation::Kahan, policy);
+    mth::Series parallel(tenth, mth::Summation::Kahan, policy);
+
+    // Past the dense region, within a chunk and at a chunk end
+    for (size_t index : {9999, 123456, 999999}) {
+
+        auto exact = 0.1 * static_cast<double>(index + 1);
+
+        mth_ASSERT_LESS(std::abs(kahan.getPartial(index).real() - exact), exact * 1e-15);
+        mth_ASSERT_EQ(parallel.getPartial(index, mth::Execution::Parallel), kahan.getPartial(index));
+    }
+}
+
+TEST(SeriesTest, FiniteUsesSummationStrategy) {
+
+    auto kahan = mth::Series::finite({1.0, 1e100, 1.0, -1e100}, mth::Summation::Kahan);
+
+    ASSERT_TRUE(kahan.getSummation() == mth::Summation::Kahan);
+    mth_ASSERT_EQ(kahan.getLimit(), mth::comp(2.0));
+    mth_ASSERT_EQ(kahan.getPartial(3), mth::comp(2.0));
+}
+
+TEST(SeriesTest, StreamsTermsAndPartialSums) {
+
+    auto halving = mth::Series::recursive([] (mth::comp a) { return a / 2.0; }, 1.0);
+
+    size_t count = 0;
+    auto expected = mth::comp(1.0);
+
+    for (auto term : halving.streamTerms(10)) {
+
+        mth_ASSERT_EQ(term, expected);
+
+        expected /= 2.0;
+        count++;
+    }
+
+    mth_ASSERT_EQ(count, size_t{10});
+
+    size_t index = 0;
+
+    for (auto partial : halving.streamPartials(100)) {
+
+        mth_ASSERT_EQ(partial, halving.getPartial(index));
+        index++;
+    }
+
+    mth_ASSERT_EQ(index, size_t{100});
+}
+
+TEST(SeriesTest, StreamTransformsCompose) {
+
+    auto leibniz = mth::Series([] (size_t index) {
+
+        return mth::comp((index % 2 == 0 ? 4.0 : -4.0) / (2.0 * index + 1.0));
+    });
+
+    auto error = [] (mth::comp value) { return (value - mth::comp(mth::pi<double>)).abs(); };
+
+    // Unbounded streams are read lazily, so stop after a fixed number of values
+    auto nth = [] (auto &&range, size_t n) {
+
+        auto it = range.begin();
+
+        for (size_t i = 0; i < n; i++) ++it;
+
+        return *it;
+    };
+
+    auto plain = nth(leibniz.streamPartials(), 20);
+    auto once = nth(mth::aitken(leibniz.streamPartials()), 20);
+    auto twice = nth(mth::aitken(mth::aitken(leibniz.streamPartials())), 20);
+    auto averaged = nth(mth::euler(leibniz.streamPartials()), 20);
+
+    mth_ASSERT_LESS(error(once), error(plain));
+    mth_ASSERT_LESS(error(twice), error(once));
+    mth_ASSERT_LESS(error(twice), 1e-7);
+    mth_ASSERT_LESS(error(averaged), 1e-5);
+
+    // Bounded ranges of any iterator end after the input is used up
+    std::vector<mth::comp> values {1.0, 0.0, 1.0, 0.0};
+    size_t count = 0;
+
+    for (auto value : mth::euler(mth::Range<std::vector<mth::comp>::const_iterator>(values.cbegin(), values.cend()))) {
+
+        mth_ASSERT_LESS(std::abs(value.real() - 0.5), 0.5 + 1e-12);
+        count++;
+    }
+
+    mth_ASSERT_EQ(count, size_t{4});
+}
+
+#ifdef mth_COROUTINES
+
+TEST(SeriesTest, GeneratorsYieldPartialSums) {
+
+    auto halving = mth::Series::recursive([] (mth::comp a) { return a / 2.0; }, 1.0);
+    auto generator = mth::generatePartials(halving);
+
+    size_t index = 0;
+
+    for (auto partial : generator) {
+
+        mth_ASSERT_EQ(partial, halving.getPartial(index));
+
+        if (++index == 20) break;
+    }
+}
+
+#endif
+
+TEST(SeriesTest, ToleranceLimitStopsOnRatioBound) {
+
+    auto exponential = mth::Series::recursive([] (size_t n, mth::comp a) { return a / static_cast<double>(n); }, 1.0);
+
+    auto result = exponential.getLimit(1e-13);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS(result.terms, size_t{20});
+    mth_ASSERT_LESS(result.error, 1e-13);
+    mth_ASSERT_LESS(std::abs(result.value.real() - std::exp(1.0)), 1e-12);
+}
+
+TEST(SeriesTest, ToleranceLimitStopsOnAlternatingBound) {
+
+    auto leibniz = mth::Series([] (size_t index) {
+
+        return mth::comp((index % 2 == 0 ? 1.0 : -1.0) / (2.0 * index + 1.0));
+    });
+
+    auto result = leibniz.getLimit(1e-3);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_EQ(result.terms, size_t{500});
+    mth_ASSERT_LESS(std::abs(result.value.real() - mth::pi<double> / 4.0), 1e-3);
+}
+
+TEST(SeriesTest, ToleranceLimitUsesGivenTailBound) {
+
+    auto basel = mth::Series([] (size_t index) {
+
+        auto n = static_cast<double>(index + 1);
+
+        return mth::comp(1.0 / (n * n));
+    });
+
+    // The tail after n + 1 terms is below the integral of 1 / x^2 from n + 1
+    auto result = basel.getLimit(1e-4, [] (size_t n) { return 1.0 / static_cast<double>(n + 1); });
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_EQ(result.terms, size_t{10000});
+    mth_ASSERT_LESS(std::abs(result.value.real() - mth::pi<double> * mth::pi<double> / 6.0), 1e-4);
+
+    // Without a bound the ratios approach one, so no tail bound is found
+    auto unbounded = basel.getLimit(1e-4, nullptr, 1000);
+
+    ASSERT_FALSE(unbounded.converged);
+    mth_ASSERT_EQ(unbounded.terms, size_t{1000});
+}
+
+TEST(SeriesTest, CauchyProductReusesFactorTerms) {
+
+    size_t evaluations = 0;
+
+    mth::Series exponential([&] (size_t index) {
+
+        evaluations++;
+
+        return mth::comp(1.0 / mth::factorial(index));
+    });
+
+    auto square = exponential * exponential;
+
+    // Terms of e^2 are 2^n / n!
+    mth_ASSERT_EQ(square.getTerm(3), mth::comp(8.0 / 6.0));
+    mth_ASSERT_LESS(std::abs(square.getPartial(30).real() - std::exp(2.0)), 1e-12);
+
+    // Each factor term is evaluated once however many product terms read it
+    mth_ASSERT_EQ(evaluations, size_t{31});
+
+    // Repeated terms of the product come from its own cache
+    square.getTerm(30);
+
+    mth_ASSERT_EQ(evaluations, size_t{31});
+}
+
+TEST(SeriesTest, ArithmeticActsTermwise) {
+
+    auto halving = mth::Series::recursive([] (mth::comp a) { return a / 2.0; }, 1.0);
+    auto thirds = mth::Series::recursive([] (mth::comp a) { return a / 3.0; }, 1.0);
+
+    auto combination = 2.0 * halving - thirds * mth::comp(0.5) + halving;
+
+    mth_ASSERT_EQ(combination.getTerm(2), mth::comp(0.75 - 0.5 / 9.0));
+    mth_ASSERT_LESS((combination.getLimit(mth::Acceleration::Wynn) - mth::comp(6.0 - 0.75)).abs(), 1e-9);
+
+    // Finite series stay finite
+    auto product = mth::Series::finite({1.0, 2.0}) * mth::Series::finite({3.0, 1.0, 1.0});
+
+    mth_ASSERT_EQ(product.getTerm(1), mth::comp(7.0));
+    mth_ASSERT_EQ(product.getLimit(), mth::comp(15.0));
+}
+
+TEST(SeriesTest, RecursiveStartsFromInitialTerm) {
+
+    auto halving = mth::Series::recursive([] (mth::comp a) { return a / 2.0; }, 1.0);
+
+    mth_ASSERT_EQ(halving.getTerm(0), mth::comp(1.0));
+    mth_ASSERT_EQ(halving.getTerm(3), mth::comp(0.125));
+    mth_ASSERT_LESS((halving.getLimit(mth::Acceleration::Wynn) - mth::comp(2.0)).abs(), 0.000000001);
+}
+
+TEST(SeriesTest, RecursiveTermsAreMemoized) {
+
+    size_t calls = 0;
+
+    auto fibonacci = mth::Series::recursive([&] (size_t, const std::vector<mth::comp> &previous) {
+
+        calls++;
+
+        return previous[0] + previous[1];
+
+    }, {0.0, 1.0});
+
+    mth_ASSERT_EQ(fibonacci.getTerm(50), mth::comp(12586269025.0));
+    mth_ASSERT_EQ(fibonacci.getTerm(10), mth::comp(55.0));
+    mth_ASSERT_EQ(fibonacci.getTerm(50), mth::comp(12586269025.0));
+
+    mth_ASSERT_EQ(calls, size_t{49});
+}
+
 TEST(SeriesTest, TrivialLimitIsAccurate) {
 
     mth::Series trivialSeries = mth::Series::finite(1.0, 2.0, 3.0, 4.0);
@@ -316,6 +784,21 @@ TEST(PowerSeriesTest, ExponentialIsAccurate) {
     mth_ASSERT_LESS(diff, 0.000001);
 }
 
+TEST(PowerSeriesTest, RecursiveWithIndexIsAccurate) {
+
+    // Coefficients of exp(z) follow a_n = a_(n - 1) / n
+    auto expSeries = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) {
+
+        return previous / static_cast<double>(n);
+
+    }, 1.0);
+
+    double diff = (expSeries.series((mth::comp) 2).getLimit() - mth::e<mth::comp> * mth::e<mth::comp>).abs();
+
+    mth_ASSERT_LESS(diff, 0.000001);
+    mth_ASSERT_LESS(0.0, expSeries.getCoeff(150).real());
+}
+
 TEST(PowerSeriesTest, TrivialLimitIsAccurate) {
 
     mth::Polynomial pol = mth::Polynomial::fromCoeffs({1.0, 2.0, 3.0});
@@ -326,6 +809,935 @@ TEST(PowerSeriesTest, TrivialLimitIsAccurate) {
     mth_ASSERT_EQ(pol.value(z), trivialSeries.series(z).getLimit());
 }
 
+TEST(PowerSeriesTest, CoefficientsAreCached) {
+
+    size_t evaluations = 0;
+
+    mth::PowerSeries geometric([&] (size_t) {
+
+        evaluations++;
+
+        return mth::comp(1.0);
+    });
+
+    auto coeffs = geometric.getCoeffs(10);
+
+    mth_ASSERT_EQ(coeffs.size(), size_t{10});
+    mth_ASSERT_EQ(geometric.truncate(4), mth::Polynomial::fromCoeffs(1.0, 1.0, 1.0, 1.0, 1.0));
+
+    geometric.getCoeff(3);
+
+    mth_ASSERT_EQ(evaluations, size_t{10});
+}
+
+TEST(PowerSeriesTest, TruncatedArithmetic) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) {
+
+        return previous / static_cast<double>(n);
+
+    }, 1.0);
+
+    auto square = exponential * exponential;
+    auto inverse = mth::reciprocal(exponential);
+    auto geometric = mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(1.0)) / mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(1.0, -1.0));
+
+    for (size_t n = 0; n < 20; n++) {
+
+        auto factorial = mth::factorial(n);
+        auto sign = n % 2 == 0 ? 1.0 : -1.0;
+
+        mth_ASSERT_EQ(square.getCoeff(n), mth::comp(std::pow(2.0, n) / factorial));
+        mth_ASSERT_EQ(inverse.getCoeff(n), mth::comp(sign / factorial));
+        mth_ASSERT_EQ(geometric.getCoeff(n), mth::comp(1.0));
+        mth_ASSERT_EQ((square - exponential * 2.0).getCoeff(n), mth::comp((std::pow(2.0, n) - 2.0) / factorial));
+    }
+
+    // The integral of exp(z) from zero is exp(z) - 1
+    auto integral = mth::integrate(exponential);
+
+    mth_ASSERT_EQ(integral.getCoeff(0), mth::comp(0.0));
+    mth_ASSERT_EQ(integral.getCoeff(5), mth::comp(1.0 / 120.0));
+
+    ASSERT_THROW(exponential / integral, std::invalid_argument);
+}
+
+TEST(PowerSeriesTest, ComposesWithZeroConstantSeries) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) {
+
+        return previous / static_cast<double>(n);
+
+    }, 1.0);
+
+    // log(1 + z) = z - z^2 / 2 + z^3 / 3 - ...
+    mth::PowerSeries logarithm([] (size_t index) {
+
+        if (index == 0) return mth::comp(0.0);
+
+        return mth::comp((index % 2 == 1 ? 1.0 : -1.0) / static_cast<double>(index));
+    });
+
+    auto identity = mth::compose(exponential, logarithm);
+
+    mth_ASSERT_EQ(identity.getCoeff(0), mth::comp(1.0));
+    mth_ASSERT_EQ(identity.getCoeff(1), mth::comp(1.0));
+
+    for (size_t n = 2; n < 24; n++) {
+
+        mth_ASSERT_ZERO(identity.getCoeff(n).abs());
+    }
+
+    ASSERT_THROW(mth::compose(logarithm, exponential), std::invalid_argument);
+}
+
+TEST(PowerSeriesTest, ComposeAtHighOrder) {
+
+    // sin(arctan(z)) = z / sqrt(1 + z^2), compared against the same series built from sqrt and reciprocal
+    auto composed = mth::compose(mth::PowerSeries::sine(), mth::PowerSeries::arctangent());
+    auto z = mth::PowerSeries::finite(mth::Polynomial::fromCoeffs({0.0, 1.0}));
+    auto radicand = mth::PowerSeries::finite(mth::Polynomial::fromCoeffs({1.0, 0.0, 1.0}));
+
+    auto direct = z * mth::reciprocal(mth::sqrt(radicand));
+
+    auto lhs = composed.getCoeffs(400);
+    auto rhs = direct.getCoeffs(400);
+
+    for (size_t n = 0; n < 400; n++) {
+
+        mth_ASSERT_LESS((lhs[n] - rhs[n]).abs(), 1e-9);
+    }
+}
+
+TEST(PowerSeriesTest, NewtonIterationAtHighOrder) {
+
+    constexpr size_t order = 20000;
+
+    // log(1 / (1 - z)) = z + z^2 / 2 + z^3 / 3 + ...
+    auto oneMinusZ = mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(1.0, -1.0));
+    auto geometric = mth::reciprocal(oneMinusZ);
+    auto logarithm = mth::log(geometric);
+
+    // exp(log(f)) and sqrt(f)^2 give f back
+    auto roundTrip = mth::exp(logarithm);
+    auto root = mth::sqrt(geometric);
+    auto square = root * root;
+
+    auto geometricCoeffs = geometric.getCoeffs(order);
+    auto logCoeffs = logarithm.getCoeffs(order);
+    auto roundTripCoeffs = roundTrip.getCoeffs(order);
+    auto squareCoeffs = square.getCoeffs(order);
+
+    for (size_t n = 0; n < order; n += 997) {
+
+        mth_ASSERT_LESS((geometricCoeffs[n] - mth::comp(1.0)).abs(), 1e-9);
+        mth_ASSERT_LESS((roundTripCoeffs[n] - mth::comp(1.0)).abs(), 1e-9);
+        mth_ASSERT_LESS((squareCoeffs[n] - mth::comp(1.0)).abs(), 1e-9);
+
+        auto expected = n == 0 ? 0.0 : 1.0 / static_cast<double>(n);
+
+        mth_ASSERT_LESS((logCoeffs[n] - mth::comp(expected)).abs(), 1e-9);
+    }
+}
+
+TEST(PowerSeriesTest, FastAndDirectMethodsAgree) {
+
+    // exp(z + z^2) at orders either side of the switch to Newton iteration
+    auto series = mth::exp(mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(0.0, 1.0, 1.0)));
+
+    // Hermite-like recurrence n a_n = a_(n - 1) + 2 a_(n - 2) from g' = (1 + 2z) g
+    std::vector<mth::comp> expected {1.0, 1.0};
+
+    for (size_t n = 2; n < 200; n++) {
+
+        expected.push_back((expected[n - 1] + 2.0 * expected[n - 2]) / static_cast<double>(n));
+    }
+
+    auto coeffs = series.getCoeffs(200);
+
+    for (size_t n = 0; n < 200; n++) {
+
+        mth_ASSERT_LESS((coeffs[n] - expected[n]).abs(), 1e-14);
+    }
+}
+
+TEST(FFTTest, ConvolutionMatchesDirectProduct) {
+
+    std::vector<mth::comp> lhs;
+    std::vector<mth::comp> rhs;
+
+    for (size_t i = 0; i < 300; i++) {
+
+        lhs.push_back(mth::comp::fromCartesian(std::sin(i * 1.0), std::cos(i * 0.5)));
+        rhs.push_back(mth::comp::fromCartesian(1.0 / (i + 1.0), 0.25));
+    }
+
+    auto product = mth::convolve(lhs, rhs);
+
+    mth_ASSERT_EQ(product.size(), size_t{599});
+
+    for (size_t n = 0; n < product.size(); n += 37) {
+
+        auto expected = mth::comp{0};
+
+        for (size_t k = 0; k <= n; k++) {
+
+            if (k < lhs.size() && n - k < rhs.size()) expected += lhs[k] * rhs[n - k];
+        }
+
+        mth_ASSERT_LESS((product[n] - expected).abs(), 1e-11);
+    }
+
+    std::vector<mth::comp> odd(3);
+
+    ASSERT_THROW(mth::fft(odd), std::invalid_argument);
+}
+
+TEST(PowerSeriesTest, HornerEvaluationMatchesSeries) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) {
+
+        return previous / static_cast<double>(n);
+
+    }, 1.0);
+
+    auto z = mth::comp::fromCartesian(1.5, -0.5);
+
+    using mth::exp;
+
+    mth_ASSERT_LESS((exponential.value(z, 40) - exp(z)).abs(), 1e-13);
+    mth_ASSERT_LESS((exponential.series(z).getPartial(40) - exponential.value(z, 40)).abs(), 1e-13);
+
+    std::vector<mth::comp> points;
+
+    for (size_t i = 0; i < 64; i++) {
+
+        points.push_back(mth::comp::fromPolar(2.0, 0.1 * i));
+    }
+
+    auto serial = exponential.values(points, 60);
+    auto parallel = exponential.values(points, 60, mth::Execution::Parallel);
+
+    for (size_t i = 0; i < points.size(); i++) {
+
+        mth_ASSERT_LESS((serial[i] - exp(points[i])).abs(), 1e-12);
+        mth_ASSERT_EQ(parallel[i], serial[i]);
+    }
+}
+
+TEST(PowerSeriesTest, EstimatesRadiusOfConvergence) {
+
+    // (1 - z / 2)^-2 has a double pole at 2, which slows the plain ratio test
+    mth::PowerSeries doublePole([] (size_t index) {
+
+        return mth::comp((index + 1.0) / std::pow(2.0, index));
+    });
+
+    mth::PowerSeries geometric([] (size_t) { return mth::comp(1.0); });
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) {
+
+        return previous / static_cast<double>(n);
+
+    }, 1.0);
+
+    mth_ASSERT_LESS(std::abs(doublePole.radius() - 2.0), 1e-6);
+    mth_ASSERT_LESS(std::abs(doublePole.radius(64, mth::RadiusMethod::Ratio) - 2.0), 0.1);
+    mth_ASSERT_LESS(std::abs(geometric.radius(64, mth::RadiusMethod::Root) - 1.0), 1e-9);
+    ASSERT_TRUE(std::isinf(exponential.radius()));
+
+    auto inside = doublePole.termsFor(1.0, 1e-10);
+
+    ASSERT_TRUE(inside.converges);
+    mth_ASSERT_LESS(inside.terms, size_t{100});
+    mth_ASSERT_LESS((doublePole.value(1.0, inside.terms - 1) - mth::comp(4.0)).abs(), 1e-10);
+
+    auto outside = geometric.termsFor(1.5, 1e-10);
+
+    ASSERT_FALSE(outside.converges);
+}
+
+TEST(PowerSeriesTest, TaylorCoefficientsFromSamples) {
+
+    auto exponential = [] (mth::comp z) {
+
+        using mth::exp;
+
+        return exp(z);
+    };
+
+    auto series = mth::PowerSeries::taylor(exponential, 1.0, 2.0, 20);
+
+    for (size_t k = 0; k < 20; k++) {
+
+        mth_ASSERT_LESS((series.getCoeff(k) - mth::comp(mth::e<double> / mth::factorial(k))).abs(), 1e-14);
+    }
+
+    mth_ASSERT_EQ(series.getCoeff(20), mth::comp(0.0));
+
+    // Near a pole the circle must stay well inside the disc to damp aliasing, at the cost of later coefficients
+    auto pole = [] (mth::comp z) { return (mth::comp(1.0) - z).inverse(); };
+    auto parallel = mth::PowerSeries::taylor(pole, 0.0, 0.5, 30, mth::Execution::Parallel);
+
+    for (size_t k = 0; k < 30; k++) {
+
+        mth_ASSERT_LESS((parallel.getCoeff(k) - mth::comp(1.0)).abs(), 1e-6);
+    }
+}
+
+TEST(PolynomialTest, ShiftRecentresPolynomial) {
+
+    // Both the direct and divide and conquer shifts, below and above the switch between them
+    for (size_t degree : {10, 300}) {
+
+        // Coefficients of (1 + i / 2) exp(z), computed without overflowing factorials
+        std::vector<mth::comp> coeffs = {mth::comp::fromCartesian(1.0, 0.5)};
+
+        for (size_t k = 1; k <= degree; k++) {
+
+            coeffs.push_back(coeffs.back() / static_cast<double>(k));
+        }
+
+        auto polynomial = mth::Polynomial::fromCoeffs(coeffs);
+        auto offset = mth::comp::fromCartesian(0.5, -0.25);
+
+        auto shifted = mth::shift(polynomial, offset);
+
+        for (auto z : {mth::comp(0.3), mth::comp::fromCartesian(-0.2, 0.7)}) {
+
+            mth_ASSERT_LESS((shifted.value(z) - polynomial.value(z + offset)).abs(), 1e-12);
+        }
+
+        auto dilated = mth::dilate(polynomial, 2.0);
+
+        mth_ASSERT_LESS((dilated.value(0.3) - polynomial.value(0.6)).abs(), 1e-12);
+    }
+}
+
+TEST(PowerSeriesTest, ShiftAndDilate) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) { return previous / static_cast<double>(n); }, 1.0);
+
+    // exp(z) about 0.5 has coefficients exp(0.5) / k!
+    auto shifted = mth::shift(exponential, 0.5, 200);
+
+    auto expected = std::exp(0.5);
+
+    for (size_t k = 0; k < 8; k++) {
+
+        mth_ASSERT_LESS((shifted.getCoeff(k) - mth::comp(expected)).abs(), 1e-12);
+
+        expected /= static_cast<double>(k + 1);
+    }
+
+    // Past a couple of thousand coefficients the binomials of (z + 1)^(n / 2) overflow a double
+    for (auto offset : {1.0, 0.5}) {
+
+        auto longShift = mth::shift(mth::PowerSeries::exponential(), offset, 4000);
+
+        auto coeff = std::exp(offset);
+
+        for (size_t k = 0; k <= 4000; k++) {
+
+            mth_ASSERT_LESS((longShift.getCoeff(k) - mth::comp(coeff)).abs(), 1e-12);
+
+            coeff /= static_cast<double>(k + 1);
+        }
+    }
+
+    mth::PowerSeries geometric([] (size_t) { return mth::comp(1.0); });
+
+    auto dilated = mth::dilate(geometric, mth::comp::fromCartesian(0.0, 2.0));
+
+    mth_ASSERT_EQ(dilated.getCoeff(3), mth::comp::fromCartesian(0.0, -8.0));
+}
+
+TEST(RationalTest, PadeApproximatesExp) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) { return previous / static_cast<double>(n); }, 1.0);
+
+    auto pade = mth::RationalFunction::pade(exponential, 6, 6);
+
+    // Far more accurate than the truncation with the same number of coefficients
+    mth_ASSERT_LESS((pade(2.0) - mth::comp(std::exp(2.0))).abs(), 1e-7);
+    mth_ASSERT_LESS(1e-6, (exponential.value(2.0, 12) - mth::comp(std::exp(2.0))).abs());
+
+    // Large points are evaluated in 1 / z
+    auto z = mth::comp::fromCartesian(30.0, 5.0);
+    auto expected = pade.getNumerator().value(z) / pade.getDenominator().value(z);
+
+    mth_ASSERT_LESS((pade(z) - expected).abs(), 1e-12 * expected.abs());
+}
+
+TEST(RationalTest, PadeWithSingularLeadingMinor) {
+
+    mth::PowerSeries cosine([] (size_t n) { return n % 2 == 1 ? 0.0 : (n % 4 == 0 ? 1.0 : -1.0) / mth::factorial(n); });
+
+    // The Toeplitz system for [1 / 2] starts with a_1 = 0, so this needs the elimination fallback
+    auto pade = mth::RationalFunction::pade(cosine, 1, 2);
+
+    mth_ASSERT_EQ(pade.getDenominator().getCoeff(0), mth::comp(1.0));
+    mth_ASSERT_EQ(pade.getDenominator().getCoeff(1), mth::comp(0.0));
+    mth_ASSERT_EQ(pade.getDenominator().getCoeff(2), mth::comp(0.5));
+    mth_ASSERT_EQ(pade.getNumerator().getCoeff(1), mth::comp(0.0));
+}
+
+TEST(RationalTest, Arithmetic) {
+
+    mth::RationalFunction inverse(mth::Polynomial::fromCoeffs(1), mth::Polynomial::fromCoeffs(0, 1));
+    mth::RationalFunction line(mth::Polynomial::fromCoeffs(1, 1));
+
+    auto z = mth::comp::fromCartesian(0.5, 2.0);
+
+    mth_ASSERT_EQ((inverse + line)(z), 1.0 / z + 1.0 + z);
+    mth_ASSERT_EQ((inverse * line)(z), (1.0 + z) / z);
+    mth_ASSERT_EQ((line / inverse)(z), z * (1.0 + z));
+    mth_ASSERT_EQ(mth::differentiate(inverse)(z), -1.0 / (z * z));
+
+    ASSERT_THROW(mth::RationalFunction(mth::Polynomial::fromCoeffs(1), mth::Polynomial()), std::invalid_argument);
+    ASSERT_THROW(line / mth::RationalFunction(), std::invalid_argument);
+}
+
+TEST(LaurentTest, PoleAndResidue) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) { return previous / static_cast<double>(n); }, 1.0);
+
+    // exp(z) / z^2 = 1 / z^2 + 1 / z + 1 / 2 + ...
+    auto laurent = mth::LaurentSeries::divide(exponential, 2);
+
+    mth_ASSERT_EQ(laurent.getPoleOrder(), size_t{2});
+    mth_ASSERT_EQ(laurent.residue(), mth::comp(1.0));
+    mth_ASSERT_EQ(laurent.getCoeff(-2), mth::comp(1.0));
+    mth_ASSERT_EQ(laurent.getCoeff(1), mth::comp(1.0 / 6.0));
+
+    auto z = mth::comp::fromCartesian(0.6, -0.3);
+
+    auto expected = mth::exp(z) / (z * z);
+
+    mth_ASSERT_LESS((laurent.value(z, 30) - expected).abs(), 1e-12);
+    mth_ASSERT_LESS((laurent.values({z}, 30, mth::Execution::Parallel)[0] - expected).abs(), 1e-12);
+
+    // d/dz exp(z) / z^2 = exp(z) (1 / z^2 - 2 / z^3)
+    auto derivative = mth::differentiate(laurent);
+
+    mth_ASSERT_EQ(derivative.getPoleOrder(), size_t{3});
+    mth_ASSERT_EQ(derivative.residue(), mth::comp(0.0));
+    mth_ASSERT_LESS((derivative.value(z, 30) - mth::exp(z) * (1.0 / (z * z) - 2.0 / (z * z * z))).abs(), 1e-12);
+
+    ASSERT_THROW(laurent.value(0.0, 10), std::invalid_argument);
+}
+
+TEST(LaurentTest, MultiplicationCancelsPoles) {
+
+    auto exponential = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) { return previous / static_cast<double>(n); }, 1.0);
+    auto decaying = mth::PowerSeries::recursive([] (size_t n, mth::comp previous) { return -previous / static_cast<double>(n); }, 1.0);
+
+    // exp(z) / z times exp(-z) / z is exactly 1 / z^2
+    auto product = mth::LaurentSeries::divide(exponential, 1) * mth::LaurentSeries::divide(decaying, 1);
+
+    mth_ASSERT_EQ(product.getPoleOrder(), size_t{2});
+    mth_ASSERT_EQ(product.getCoeff(-2), mth::comp(1.0));
+    mth_ASSERT_EQ(product.residue(), mth::comp(0.0));
+
+    for (size_t k = 0; k < 10; k++) {
+
+        mth_ASSERT_EQ(product.getCoeff(static_cast<std::ptrdiff_t>(k)), mth::comp(0.0));
+    }
+
+    // The analytic parts add without touching the pole
+    auto sum = product + mth::LaurentSeries(exponential);
+
+    mth_ASSERT_EQ(sum.getCoeff(-2), mth::comp(1.0));
+    mth_ASSERT_EQ(sum.getCoeff(0), mth::comp(1.0));
+    mth_ASSERT_EQ((sum - product).getPoleOrder(), size_t{0});
+}
+
+TEST(PowerSeriesTest, ElementarySeries) {
+
+    // Well past where mth::factorial stops
+    auto relativeError = [] (mth::comp actual, double expected) { return (actual - mth::comp(expected)).abs() / std::abs(expected); };
+
+    mth_ASSERT_LESS(relativeError(mth::PowerSeries::exponential().getCoeff(150), std::exp(-std::lgamma(151.0))), 1e-12);
+    mth_ASSERT_LESS(relativeError(mth::PowerSeries::sine().getCoeff(101), std::exp(-std::lgamma(102.0))), 1e-12);
+    mth_ASSERT_LESS(relativeError(mth::PowerSeries::cosine().getCoeff(102), -std::exp(-std::lgamma(103.0))), 1e-12);
+    mth_ASSERT_EQ(mth::PowerSeries::sine().getCoeff(100), mth::comp(0.0));
+
+    // Products go through the usual arithmetic: exp(z)^2 has coefficients 2^n / n!
+    auto square = mth::PowerSeries::exponential() * mth::PowerSeries::exponential();
+
+    mth_ASSERT_LESS(relativeError(square.getCoeff(20), std::exp(20.0 * std::log(2.0) - std::lgamma(21.0))), 1e-12);
+
+    // sin^2 + cos^2 = 1
+    auto sine = mth::PowerSeries::sine();
+    auto cosine = mth::PowerSeries::cosine();
+    auto identity = sine * sine + cosine * cosine;
+
+    mth_ASSERT_EQ(identity.getCoeff(0), mth::comp(1.0));
+
+    for (size_t n = 1; n < 40; n++) {
+
+        mth_ASSERT_ZERO(identity.getCoeff(n));
+    }
+
+    auto logarithm = mth::log(mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(1.0, 1.0)));
+    auto arctangent = mth::integrate(mth::reciprocal(mth::PowerSeries::finite(mth::Polynomial::fromCoeffs(1.0, 0.0, 1.0))));
+
+    for (size_t n = 0; n < 20; n++) {
+
+        mth_ASSERT_EQ(mth::PowerSeries::logarithm().getCoeff(n), logarithm.getCoeff(n));
+        mth_ASSERT_EQ(mth::PowerSeries::arctangent().getCoeff(n), arctangent.getCoeff(n));
+    }
+
+    // sqrt(1 + z)^2 = 1 + z, and natural exponents terminate
+    auto root = mth::PowerSeries::binomial(0.5);
+
+    mth_ASSERT_EQ((root * root).truncate(30), mth::Polynomial::fromCoeffs(1.0, 1.0));
+    mth_ASSERT_EQ(mth::PowerSeries::binomial(3.0).truncate(10), mth::Polynomial::fromCoeffs(1.0, 3.0, 3.0, 1.0));
+}
+
+TEST(JetTest, DerivativesOfElementaryFunctions) {
+
+    constexpr size_t order = 6;
+
+    auto x = mth::jet<order>::variable(0.7);
+
+    auto exponential = mth::exp(x);
+    auto sine = mth::sin(x);
+    auto cosine = mth::cos(x);
+    auto logarithm = mth::log(x);
+    auto root = mth::sqrt(x);
+
+    // The kth derivative of x^2 exp(x) is (x^2 + 2kx + k(k - 1)) exp(x)
+    auto product = x * x * exponential;
+
+    // The kth derivative of 1 / (1 - x) is k! / (1 - x)^(k + 1)
+    auto quotient = 1.0 / (1.0 - x);
+
+    auto factorial = 1.0;
+
+    for (size_t k = 0; k <= order; k++) {
+
+        auto n = static_cast<double>(k);
+
+        if (k > 0) factorial *= n;
+
+        mth_ASSERT_LESS(std::abs(exponential.derivative(k) - std::exp(0.7)), 1e-13);
+        mth_ASSERT_LESS(std::abs(sine.derivative(k) - std::sin(0.7 + n * mth::pi<double> / 2)), 1e-13);
+        mth_ASSERT_LESS(std::abs(cosine.derivative(k) - std::cos(0.7 + n * mth::pi<double> / 2)), 1e-13);
+        mth_ASSERT_LESS(std::abs(product.derivative(k) - (0.49 + 1.4 * n + n * (n - 1)) * std::exp(0.7)), 1e-12);
+        mth_ASSERT_LESS(std::abs(quotient.derivative(k) - factorial / std::pow(0.3, n + 1)), 1e-9 * factorial / std::pow(0.3, n + 1));
+
+        if (k > 0) {
+
+            // The kth derivative of log(x) is (-1)^(k - 1) (k - 1)! / x^k
+            auto expected = (k % 2 == 1 ? 1.0 : -1.0) * factorial / n / std::pow(0.7, n);
+
+            mth_ASSERT_LESS(std::abs(logarithm.derivative(k) - expected), 1e-10 * std::abs(expected));
+        }
+    }
+
+    mth_ASSERT_LESS(std::abs(root.derivative(0) - std::sqrt(0.7)), 1e-15);
+    mth_ASSERT_LESS(std::abs(root.derivative(1) - 0.5 / std::sqrt(0.7)), 1e-14);
+    mth_ASSERT_LESS(std::abs(root.derivative(2) + 0.25 / std::pow(0.7, 1.5)), 1e-14);
+}
+
+TEST(JetTest, ComplexJets) {
+
+    auto z = mth::cjet<4>::variable(mth::comp::fromCartesian(0.3, -1.2));
+
+    auto sine = mth::sin(z);
+    auto cosine = mth::cos(z);
+    auto identity = sine * sine + cosine * cosine;
+
+    mth_ASSERT_LESS((identity[0] - mth::comp(1.0)).abs(), 1e-14);
+
+    for (size_t k = 1; k <= 4; k++) {
+
+        mth_ASSERT_LESS(identity[k].abs(), 1e-14);
+    }
+
+    // sqrt(z)^2 and exp(log(z)) recover z, including its derivative
+    auto root = mth::sqrt(z);
+    auto recovered = mth::exp(mth::log(z));
+
+    for (size_t k = 0; k <= 4; k++) {
+
+        mth_ASSERT_LESS(((root * root)[k] - z[k]).abs(), 1e-14);
+        mth_ASSERT_LESS((recovered[k] - z[k]).abs(), 1e-14);
+    }
+
+    mth_ASSERT_LESS((mth::sin(mth::comp(0.4)) - mth::comp(std::sin(0.4))).abs(), 1e-15);
+    mth_ASSERT_LESS((mth::cos(mth::comp(0.4)) - mth::comp(std::cos(0.4))).abs(), 1e-15);
+}
+
+TEST(SpecialTest, FactorialsAndBinomials) {
+
+    mth_ASSERT_EQ(mth::factorial(20), 2432902008176640000.0);
+    mth_ASSERT_LESS(std::abs(mth::factorial(170) / 7.257415615307998967e306 - 1.0), 1e-15);
+    ASSERT_TRUE(std::isinf(mth::factorial(171)));
+
+    mth_ASSERT_LESS(std::abs(mth::logFactorial(100) - std::lgamma(101.0)), 1e-12);
+    mth_ASSERT_LESS(std::abs(mth::logFactorial(1000) - std::lgamma(1001.0)), 1e-12);
+
+    auto logs = mth::logFactorial(std::vector<size_t>{0, 1, 5, 500}, mth::Execution::Parallel);
+
+    mth_ASSERT_EQ(logs[0], 0.0);
+    mth_ASSERT_EQ(logs[1], 0.0);
+    mth_ASSERT_LESS(std::abs(logs[2] - std::log(120.0)), 1e-15);
+    mth_ASSERT_LESS(std::abs(logs[3] - std::lgamma(501.0)), 1e-12);
+
+    mth_ASSERT_EQ(mth::binomial(10, 3), 120.0);
+    mth_ASSERT_EQ(mth::binomial(3, 10), 0.0);
+    mth_ASSERT_EQ(mth::binomial(60, 30), 118264581564861424.0);
+
+    // Exact integers just below 2^53, where multiplying before dividing in doubles rounds
+    ASSERT_EQ(mth::binomial(55, 26), 3560597348629860.0);
+    ASSERT_EQ(mth::binomial(56, 27), 7384942649010080.0);
+
+    // Past the factorial table, through log space
+    mth_ASSERT_LESS(std::abs(mth::binomial(1000, 500) / 2.702882409454365e299 - 1.0), 1e-12);
+    mth_ASSERT_LESS(std::abs(mth::logBinomial(5000, 2500) - (std::lgamma(5001.0) - 2.0 * std::lgamma(2501.0))), 1e-9);
+}
+
+TEST(SpecialTest, ComplexGamma) {
+
+    auto sqrtPi = std::sqrt(mth::pi<double>);
+
+    mth_ASSERT_LESS((mth::gamma(5.0) - mth::comp(24.0)).abs(), 1e-12);
+    mth_ASSERT_LESS((mth::gamma(0.5) - mth::comp(sqrtPi)).abs(), 1e-14);
+    mth_ASSERT_LESS((mth::gamma(-0.5) - mth::comp(-2.0 * sqrtPi)).abs(), 1e-14);
+
+    auto value = mth::gamma(mth::comp::fromCartesian(1.0, 1.0));
+
+    mth_ASSERT_LESS((value - mth::comp::fromCartesian(0.4980156681183560, -0.1549498283018106)).abs(), 1e-14);
+
+    // Finite far past where gamma itself overflows
+    mth_ASSERT_LESS(std::abs(mth::lgamma(300.0).real() / std::lgamma(300.0) - 1.0), 1e-14);
+
+    auto values = mth::gamma(std::vector<mth::comp>{1.0, 2.0, 3.5}, mth::Execution::Parallel);
+
+    mth_ASSERT_LESS((values[2] - mth::comp(3.323350970447843)).abs(), 1e-13);
+
+    ASSERT_THROW(mth::gamma(-2.0), std::invalid_argument);
+    ASSERT_THROW(mth::lgamma(0.0), std::invalid_argument);
+}
+
+TEST(NumericTest, ParallelLimitMatchesSerial) {
+
+    auto function = [] (mth::comp z) {
+
+        using mth::exp;
+
+        return (exp(z) - mth::comp(1)) / z;
+    };
+
+    auto serial = mth::limit(function, mth::comp(0));
+    auto parallel = mth::limit(function, mth::comp(0), mth::Execution::Parallel);
+
+    mth_ASSERT_EQ(serial, parallel);
+    mth_ASSERT_LESS((parallel - mth::comp(1)).abs(), 0.000001);
+}
+
+TEST(SummationTest, KahanRecoversCancelledTerms) {
+
+    std::vector<mth::comp> values {1.0, 1e100, 1.0, -1e100};
+
+    mth::Accumulator naive;
+    mth::Accumulator kahan(mth::Summation::Kahan);
+
+    for (const auto &value : values) {
+
+        naive.add(value);
+        kahan.add(value);
+    }
+
+    mth_ASSERT_EQ(naive.total(), mth::comp(0.0));
+    mth_ASSERT_EQ(kahan.total(), mth::comp(2.0));
+    mth_ASSERT_EQ(mth::sum(values, mth::Summation::Kahan), mth::comp(2.0));
+}
+
+TEST(SummationTest, NaiveSumAddsInOrder) {
+
+    // In order the first 1 is absorbed by 1e100 and only the last survives
+    std::vector<mth::comp> values {1e100, 1.0, -1e100, 1.0};
+
+    mth::Accumulator naive;
+
+    for (const auto &value : values) naive.add(value);
+
+    mth_ASSERT_EQ(naive.total(), mth::comp(1.0));
+    mth_ASSERT_EQ(mth::sum(values, mth::Summation::Naive), mth::comp(1.0));
+}
+
+TEST(SummationTest, StrategiesAgreeOnLongSums) {
+
+    std::vector<mth::comp> values(100000, mth::comp::fromCartesian(0.1, -0.3));
+    auto exact = mth::comp::fromCartesian(10000.0, -30000.0);
+
+    for (auto method : {mth::Summation::Naive, mth::Summation::Kahan, mth::Summation::Pairwise}) {
+
+        mth::Accumulator accumulator(method);
+
+        for (const auto &value : values) accumulator.add(value);
+
+        mth_ASSERT_LESS((accumulator.total() - exact).abs(), 1e-6);
+        mth_ASSERT_LESS((mth::sum(values, method) - exact).abs(), 1e-6);
+    }
+
+    // Compensated and pairwise errors stay near a single rounding
+    mth_ASSERT_LESS((mth::sum(values, mth::Summation::Kahan) - exact).abs(), 1e-11);
+    mth_ASSERT_LESS((mth::sum(values, mth::Summation::Pairwise) - exact).abs(), 1e-11);
+}
+
+TEST(ParallelTest, ParallelForVisitsEachIndexOnce) {
+
+    mth::ThreadPool pool(4);
+
+    std::vector<int> visits(1000, 0);
+
+    pool.parallelFor(visits.size(), [&] (size_t i) { visits[i]++; });
+
+    for (auto count : visits) {
+
+        mth_ASSERT_EQ(count, 1);
+    }
+}
+
+TEST(ParallelTest, ParallelForRethrowsExceptions) {
+
+    mth::ThreadPool pool(2);
+
+    ASSERT_THROW(pool.parallelFor(10, [] (size_t i) {
+
+        if (i == 7) throw std::runtime_error("failed sample");
+
+    }), std::runtime_error);
+}
+
+TEST(RootsTest, NewtonFindsComplexRoot) {
+
+    auto function = [] (mth::comp z) { return z * z + mth::comp(1); };
+    auto derivative = [] (mth::comp z) { return 2.0 * z; };
+
+    auto result = mth::newton(function, derivative, mth::comp::fromCartesian(0.5, 0.5));
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.root - mth::i<double>).abs(), 0.000000001);
+    mth_ASSERT_LESS(result.iterations, 20);
+}
+
+TEST(RootsTest, NewtonWithNumericDerivative) {
+
+    std::function<mth::comp(mth::comp)> function = [] (mth::comp z) { return z * z * z - mth::comp(8); };
+
+    auto result = mth::newton(function, mth::comp(3));
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.root - mth::comp(2)).abs(), 0.000001);
+    mth_ASSERT_LESS(result.iterations + 1, result.evaluations);
+}
+
+TEST(RootsTest, NewtonWithJetDerivative) {
+
+    auto function = [] (const mth::cjet<1> &z) { return z * z * z - mth::comp(8); };
+
+    auto result = mth::newtonJet(function, mth::comp(3));
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.root - mth::comp(2)).abs(), 0.000000001);
+
+    // One jet evaluation per iteration, plus the initial guess
+    ASSERT_EQ(result.evaluations, result.iterations + 1);
+}
+
+TEST(RootsTest, SecantFindsCubeRoot) {
+
+    auto function = [] (mth::comp z) { return z * z * z - mth::comp(2); };
+
+    auto result = mth::secant(function, mth::comp(1), mth::comp(2));
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.root - mth::comp(std::cbrt(2.0))).abs(), 0.000000001);
+    mth_ASSERT_EQ(result.evaluations, result.iterations + 2);
+}
+
+TEST(RootsTest, MullerReachesComplexRootFromRealPoints) {
+
+    auto function = [] (mth::comp z) { return z * z + z + mth::comp(1); };
+
+    auto result = mth::muller(function, mth::comp(0), mth::comp(1), mth::comp(2));
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS(function(result.root).abs(), 0.000000001);
+    mth_ASSERT_LESS(0.5, std::abs(result.root.imag()));
+}
+
+TEST(RootsTest, BrentFindsBracketedRoot) {
+
+    auto function = [] (double x) { return std::cos(x) - x; };
+
+    auto result = mth::brent(function, 0.0, 1.0);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS(std::abs(result.root - 0.7390851332151607), 0.000000001);
+    mth_ASSERT_LESS(result.evaluations, 20);
+}
+
+TEST(RootsTest, BrentRejectsUnbracketedInterval) {
+
+    auto function = [] (double x) { return x * x + 1.0; };
+
+    ASSERT_THROW(mth::brent(function, -1.0, 1.0), std::invalid_argument);
+}
+
+TEST(QuadratureTest, IntegratesSmoothFunction) {
+
+    auto function = [] (double x) {
+
+        using mth::exp;
+
+        return exp(mth::comp(x));
+    };
+
+    auto result = mth::integrate(function, 0.0, 1.0);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.value - mth::comp(mth::e<double> - 1.0)).abs(), 0.0000000001);
+    mth_ASSERT_EQ(result.evaluations, size_t{15});
+}
+
+TEST(QuadratureTest, AdaptsToEndpointSingularity) {
+
+    auto function = [] (double x) { return 1.0 / std::sqrt(x); };
+
+    auto result = mth::integrate(function, 0.0, 1.0);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS(std::abs(result.value - 2.0), 0.000000001);
+    mth_ASSERT_LESS(1, result.intervals);
+}
+
+TEST(QuadratureTest, IntegratesVectorValues) {
+
+    auto function = [] (double x) { return mth::vec2(std::cos(x), std::sin(x)); };
+
+    auto result = mth::integrate(function, 0.0, mth::pi<double> / 2.0);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS((result.value - mth::vec2(1.0, 1.0)).magn(), 0.0000000001);
+}
+
+TEST(QuadratureTest, CircleContourGivesResidue) {
+
+    auto function = [] (mth::comp z) { return z.inverse(); };
+
+    auto result = mth::integrateCircle(function, mth::comp(0), 2.0);
+
+    auto expected = mth::tau<double> * mth::i<double>;
+
+    mth_ASSERT_LESS((result.value - expected).abs(), 0.0000000001);
+}
+
+TEST(QuadratureTest, LineContourMatchesAntiderivative) {
+
+    auto function = [] (mth::comp z) { return z * z; };
+
+    auto end = mth::comp::fromCartesian(1.0, 2.0);
+    auto result = mth::integrateLine(function, mth::comp(0), end);
+
+    mth_ASSERT_LESS((result.value - end * end * end / 3.0).abs(), 0.0000000001);
+}
+
+TEST(QuadratureTest, ParallelMatchesSerialWithinTolerance) {
+
+    auto function = [] (double x) { return std::abs(std::sin(10.0 * x)); };
+
+    mth::QuadratureOptions options;
+    options.execution = mth::Execution::Parallel;
+
+    auto serial = mth::integrate(function, 0.0, mth::pi<double>);
+    auto parallel = mth::integrate(function, 0.0, mth::pi<double>, options);
+
+    ASSERT_TRUE(parallel.converged);
+    mth_ASSERT_LESS(std::abs(serial.value - 2.0), 0.000000001);
+    mth_ASSERT_LESS(std::abs(parallel.value - 2.0), 0.000000001);
+}
+
+TEST(CubatureTest, SobolStartsWithDyadicPoints) {
+
+    mth_ASSERT_EQ((mth::sobol<double, 2>(1)), mth::vec2(0.5, 0.5));
+    mth_ASSERT_EQ((mth::sobol<double, 2>(2)), mth::vec2(0.75, 0.25));
+    mth_ASSERT_EQ((mth::sobol<double, 2>(3)), mth::vec2(0.25, 0.75));
+}
+
+TEST(CubatureTest, GenzMalikIntegratesExponential) {
+
+    auto function = [] (const mth::vec5 &x) {
+
+        auto sum = 0.0;
+
+        for (auto value : x) sum += value;
+
+        return std::exp(sum);
+    };
+
+    mth::vec5 lower;
+    mth::vec5 upper(1.0, 1.0, 1.0, 1.0, 1.0);
+
+    auto result = mth::integrateBox(function, lower, upper);
+
+    ASSERT_TRUE(result.converged);
+    mth_ASSERT_LESS(std::abs(result.value - std::pow(mth::e<double> - 1.0, 5)), 0.0001);
+}
+
+TEST(CubatureTest, ParallelGenzMalikMatchesSerial) {
+
+    auto function = [] (const mth::vec3 &x) { return mth::comp(1.0 / (1.0 + x.dot(x))); };
+
+    mth::vec3 lower(-1.0, -1.0, -1.0);
+    mth::vec3 upper(1.0, 1.0, 1.0);
+
+    mth::CubatureOptions options;
+    options.execution = mth::Execution::Parallel;
+
+    auto serial = mth::integrateBox(function, lower, upper);
+    auto parallel = mth::integrateBox(function, lower, upper, options);
+
+    ASSERT_TRUE(parallel.converged);
+    mth_ASSERT_LESS((serial.value - parallel.value).abs(), 0.00001);
+}
+
+TEST(CubatureTest, QuasiMonteCarloInNineDimensions) {
+
+    auto function = [] (const mth::vec9 &x) {
+
+        auto product = 1.0;
+
+        for (auto value : x) product *= 0.5 + value;
+
+        return product;
+    };
+
+    mth::vec9 lower;
+    mth::vec9 upper(1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0);
+
+    mth::CubatureOptions options;
+    options.absTolerance = 0.001;
+    options.relTolerance = 0.0;
+    options.execution = mth::Execution::Parallel;
+
+    for (auto sequence : {mth::LowDiscrepancy::Sobol, mth::LowDiscrepancy::Halton}) {
+
+        options.sequence = sequence;
+
+        auto result = mth::quasiMonteCarlo(function, lower, upper, options);
+
+        ASSERT_TRUE(result.converged);
+        mth_ASSERT_LESS(std::abs(result.value - 1.0), 0.01);
+        mth_ASSERT_LESS(result.evaluations, options.maxEvaluations);
+    }
+}
+
 // TODO: Test quat
 // TODO: Test polynomial
 // TODO: Test numeric functions
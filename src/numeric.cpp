@@ -1,32 +1,63 @@
 
+#include <algorithm>
+#include <limits>
+
 #include <mth/mth.h>
 
 #include <mth/numeric.h>
+#include <mth/parallel.h>
 #include <mth/polynomial.h>
 
 // Return a polynomial interpolated through points (xTransform(t), yFunc(t)) with t approaching zero from above on the real axis
-mth::Polynomial lerpTowards(std::function<mth::comp(mth::comp)> xTransform, std::function<mth::comp(size_t,mth::comp)> yFunc) {
+mth::Polynomial lerpTowards(std::function<mth::comp(mth::comp)> xTransform, std::function<mth::comp(size_t,mth::comp)> yFunc,
+                            mth::Execution execution) {
 
     using std::pow;
     using std::abs;
 
+    constexpr size_t firstSample = 2;
+    constexpr size_t lastSample = 100;
+
     std::vector<mth::cvec2> result;
 
-    for (size_t i = 2; i < 100; i++) {
+    // Parallel samples are evaluated in batches of the pool size so that we stop close to where a serial run would
+    auto batchSize = execution == mth::Execution::Parallel ? std::max(size_t{1}, mth::ThreadPool::shared().size()) : size_t{1};
 
-        // TODO: Parametrize this sequence or choose it contextually
-        auto approachingZero = pow(mth::comp(2), -mth::comp(i));
+    auto finished = false;
 
-        auto x = xTransform(approachingZero);
-        auto y = yFunc(i, x);
+    for (size_t first = firstSample; first < lastSample && !finished; first += batchSize) {
 
-        // If sequence is close enough to cause division by zero then we can probably break
-        if (std::isnan(y.real()) || std::isnan(y.imag()) || std::isnan(x.real()) || std::isnan(x.imag())) {
+        auto count = std::min(batchSize, lastSample - first);
 
-            break;
-        }
+        std::vector<mth::cvec2> samples(count);
+
+        mth::forEachIndex(count, [&] (size_t j) {
+
+            // TODO: Parametrize this sequence or choose it contextually
+            auto approachingZero = pow(mth::comp(2), -mth::comp(first + j));
+
+            auto x = xTransform(approachingZero);
+            auto y = yFunc(first + j, x);
+
+            samples[j] = mth::cvec2(x, y);
+
+        }, execution);
+
+        // Samples are collected in order so the result doesn't depend on scheduling
+        for (const auto &sample : samples) {
+
+            auto x = sample.x();
+            auto y = sample.y();
+
+            // If sequence is close enough to cause division by zero then we can probably break
+            if (std::isnan(y.real()) || std::isnan(y.imag()) || std::isnan(x.real()) || std::isnan(x.imag())) {
 
-        result.push_back(mth::cvec2(x, y));
+                finished = true;
+                break;
+            }
+
+            result.push_back(sample);
+        }
     }
 
     // number of vertices to interpolate
@@ -88,70 +119,378 @@ std::function<mth::comp(size_t)> aitkenTransform(const std::function<mth::comp(s
     };
 }
 
-mth::comp mth::limit(const std::function<mth::comp(size_t)> &sequence) {
+mth::comp mth::limit(const std::function<mth::comp(size_t)> &sequence, mth::Execution execution) {
 
     auto accelerated = aitkenTransform(sequence);
 
     auto id = [] (comp z) { return z; };
     auto y = [&] (size_t index, comp x) { return accelerated(index); };
 
-    auto pol = lerpTowards(id, y);
+    auto pol = lerpTowards(id, y, execution);
 
     return pol.getCoeff(0);
 }
 
-mth::comp mth::seriesLimit(const std::function<mth::comp(size_t)> &partialSum, const std::function<mth::comp(size_t)> &sequence) {
+// Maximum number of terms an accelerated series limit will evaluate
+constexpr size_t accelerationMaxTerms = 100;
+
+// Relative change between estimates below which an accelerated series limit is considered converged
+constexpr double accelerationTolerance = 1e3 * mth::epsilon<double>;
+
+// Overloads to feed each transform what it uses of the series
+
+void pushTo(mth::WynnEpsilon &transform, const mth::comp &partial, const mth::comp &) {
+
+    transform.push(partial);
+}
+
+void pushTo(mth::LevinU &transform, const mth::comp &partial, const mth::comp &term) {
+
+    transform.push(partial, term);
+}
+
+void pushTo(mth::EulerTransform &transform, const mth::comp &, const mth::comp &term) {
+
+    transform.push(term);
+}
+
+// Feed terms of a series into an incremental transform until its estimates settle
+template <typename Transform>
+mth::comp accelerate(const std::function<mth::comp(size_t)> &sequence, Transform &transform) {
+
+    using std::abs;
+    using std::max;
+
+    auto partial = mth::comp{0};
+
+    auto best = mth::comp{0};
+    auto bestError = std::numeric_limits<double>::infinity();
+
+    size_t settled = 0;
+
+    for (size_t n = 0; n < accelerationMaxTerms; n++) {
+
+        auto term = sequence(n);
+
+        // Terms that aren't representable won't improve the estimate
+        if (std::isnan(term.real()) || std::isnan(term.imag())) break;
+
+        partial += term;
+        pushTo(transform, partial, term);
+
+        auto estimate = transform.estimate();
+        auto error = transform.error();
+
+        if (std::isnan(error)) continue;
+
+        if (error <= bestError) {
+
+            best = estimate;
+            bestError = error;
+        }
+
+        // Require two consecutive small changes so a single coincidence doesn't stop early
+        if (n > 1 && error <= accelerationTolerance * max(1.0, estimate.abs())) {
+
+            if (++settled == 2) break;
+
+        } else {
+
+            settled = 0;
+        }
+    }
+
+    return best;
+}
+
+mth::WynnEpsilon::WynnEpsilon(size_t maxColumns)
+    :maxColumns(maxColumns) {}
+
+void mth::WynnEpsilon::push(const mth::comp &partial) {
+
+    std::vector<comp> next;
+    next.reserve(std::min(diagonal.size() + 1, maxColumns + 1));
+
+    next.push_back(partial);
+
+    // next[k + 1] = epsilon_(k - 1) from the last diagonal + 1 / (next[k] - diagonal[k])
+    for (size_t k = 0; k < diagonal.size() && k < maxColumns; k++) {
+
+        auto denom = next[k] - diagonal[k];
+
+        // Stop the diagonal where it has converged exactly
+        if (util::isZero(denom.abs())) break;
+
+        auto before = k == 0 ? comp{0} : diagonal[k - 1];
+
+        next.push_back(before + denom.inverse());
+    }
+
+    diagonal = std::move(next);
+    count++;
+
+    // Only even columns approximate the limit
+    auto column = (diagonal.size() - 1) & ~size_t{1};
+
+    previous = current;
+    current = diagonal[column];
+}
+
+mth::comp mth::WynnEpsilon::estimate() const {
+
+    return current;
+}
+
+double mth::WynnEpsilon::error() const {
+
+    if (count < 2) return std::numeric_limits<double>::infinity();
+
+    return (current - previous).abs();
+}
+
+size_t mth::WynnEpsilon::size() const {
+
+    return count;
+}
+
+mth::LevinU::LevinU(size_t maxOrder)
+    :maxOrder(maxOrder) {}
+
+void mth::LevinU::push(const mth::comp &partial, const mth::comp &term) {
+
+    auto n = count++;
+
+    previous = current;
+
+    // A zero remainder estimate means the partial sum is exact so far; restart the tableau
+    if (util::isZero(term.abs())) {
+
+        numerators.clear();
+        denominators.clear();
+
+        current = partial;
+
+        return;
+    }
+
+    // Remainder estimate for the u-transform with beta = 1
+    auto omega = term * static_cast<double>(n + 1);
+    auto weight = omega.inverse();
+
+    std::vector<comp> nextNumerators {partial * weight};
+    std::vector<comp> nextDenominators {weight};
+
+    // Weniger's recursion P_k^(m) = P_(k-1)^(m+1) - c(k, m) P_(k-1)^(m) with m = n - k
+    for (size_t k = 1; k <= numerators.size() && k <= maxOrder; k++) {
+
+        auto m = static_cast<double>(n - k) + 1.0;
+
+        // c(k, m) = (m)(m + k - 1)^(k - 2) / (m + k)^(k - 1), written as ratios to avoid overflow
+        auto ratio = (m + k - 1) / (m + k);
+        auto factor = m / (m + k) * std::pow(ratio, static_cast<double>(k) - 2.0);
+
+        nextNumerators.push_back(nextNumerators[k - 1] - factor * numerators[k - 1]);
+        nextDenominators.push_back(nextDenominators[k - 1] - factor * denominators[k - 1]);
+    }
+
+    numerators = std::move(nextNumerators);
+    denominators = std::move(nextDenominators);
+
+    auto order = numerators.size() - 1;
+
+    if (util::isZero(denominators[order].abs())) {
+
+        current = partial;
+
+    } else {
+
+        current = numerators[order] / denominators[order];
+    }
+}
+
+mth::comp mth::LevinU::estimate() const {
+
+    return current;
+}
+
+double mth::LevinU::error() const {
+
+    if (count < 2) return std::numeric_limits<double>::infinity();
+
+    return (current - previous).abs();
+}
+
+size_t mth::LevinU::size() const {
+
+    return count;
+}
+
+void mth::EulerTransform::push(const mth::comp &term) {
+
+    count++;
+
+    previous = current;
+
+    if (differences.empty()) {
+
+        differences.push_back(term);
+        current = 0.5 * term;
+
+        return;
+    }
+
+    // Average the new term into each order of differences; differences[j] holds the jth order for the latest terms
+    auto order = differences.size();
+    auto carried = differences[0];
+
+    differences[0] = term;
+
+    for (size_t j = 1; j < order; j++) {
+
+        auto next = differences[j];
+
+        differences[j] = 0.5 * (differences[j - 1] + carried);
+        carried = next;
+    }
+
+    auto highest = 0.5 * (differences[order - 1] + carried);
+
+    // Van Wijngaarden's criterion: raise the order while the differences shrink, otherwise add the term directly
+    if (highest.abs() <= differences[order - 1].abs()) {
+
+        differences.push_back(highest);
+        current += 0.5 * highest;
+
+    } else {
+
+        current += highest;
+    }
+}
+
+mth::comp mth::EulerTransform::estimate() const {
+
+    return current;
+}
+
+double mth::EulerTransform::error() const {
+
+    if (count < 2) return std::numeric_limits<double>::infinity();
+
+    return (current - previous).abs();
+}
+
+size_t mth::EulerTransform::size() const {
+
+    return count;
+}
+
+bool mth::isAlternating(const std::function<mth::comp(size_t)> &sequence, size_t first, size_t count) {
+
+    if (count < 2) return false;
+
+    auto term = sequence(first);
+
+    for (size_t n = first + 1; n < first + count; n++) {
+
+        auto next = sequence(n);
+
+        if (util::isZero(term.abs()) || util::isZero(next.abs())) return false;
+
+        auto ratio = next / term;
+
+        if (ratio.real() >= 0.0 || !util::isZero(ratio.imag() / ratio.real())) return false;
+
+        term = next;
+    }
+
+    return true;
+}
+
+mth::comp mth::seriesLimit(const std::function<mth::comp(size_t)> &partialSum, const std::function<mth::comp(size_t)> &sequence,
+                           mth::Acceleration method) {
+
+    if (method == Acceleration::Automatic) {
+
+        method = isAlternating(sequence) ? Acceleration::Euler : Acceleration::Shanks;
+    }
+
+    switch (method) {
+
+        case Acceleration::Wynn: {
+
+            WynnEpsilon transform;
+
+            return accelerate(sequence, transform);
+        }
+
+        case Acceleration::Levin: {
+
+            LevinU transform;
+
+            return accelerate(sequence, transform);
+        }
+
+        case Acceleration::Euler: {
+
+            EulerTransform transform;
+
+            return accelerate(sequence, transform);
+        }
+
+        default: break;
+    }
 
     auto accelerated = shankTransform(partialSum, sequence);
 
     auto id = [] (comp z) { return z; };
     auto y = [&] (size_t index, comp x) { return accelerated(index); };
 
-    auto pol = lerpTowards(id, y);
+    auto pol = lerpTowards(id, y, Execution::Serial);
 
     return pol.getCoeff(0);
 }
 
-mth::comp mth::lowerLimit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input) {
+mth::comp mth::lowerLimit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input, mth::Execution execution) {
 
     auto x = [&] (comp small) { return input - small; };
     auto y = [&] (size_t index, comp x) { return function(x); };
 
-    auto pol = lerpTowards(x, y);
+    auto pol = lerpTowards(x, y, execution);
 
     return pol.getCoeff(0);
 }
 
-mth::comp mth::upperLimit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input) {
+mth::comp mth::upperLimit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input, mth::Execution execution) {
 
     auto x = [&] (comp small) { return input + small; };
     auto y = [&] (size_t index, comp x) { return function(x); };
 
-    auto pol = lerpTowards(x, y);
+    auto pol = lerpTowards(x, y, execution);
 
     return pol.getCoeff(0);
 }
 
-mth::comp mth::limit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input) {
+mth::comp mth::limit(const std::function<mth::comp(mth::comp)> &function, const mth::comp &input, mth::Execution execution) {
 
-    return lowerLimit(function, input);
+    return lowerLimit(function, input, execution);
 }
 
-mth::comp mth::limitInfPos(const std::function<mth::comp(mth::comp)> &function) {
+mth::comp mth::limitInfPos(const std::function<mth::comp(mth::comp)> &function, mth::Execution execution) {
 
     auto inverted = [function] (mth::comp z) { return function(z.inverse()); };
-    return upperLimit(inverted, comp(0));
+    return upperLimit(inverted, comp(0), execution);
 }
 
-mth::comp mth::limitInfNeg(const std::function<mth::comp(mth::comp)> &function) {
+mth::comp mth::limitInfNeg(const std::function<mth::comp(mth::comp)> &function, mth::Execution execution) {
 
     auto inverted = [function] (mth::comp z) { return function(z.inverse()); };
-    return lowerLimit(inverted, comp(0));
+    return lowerLimit(inverted, comp(0), execution);
 }
 
 std::function<mth::comp(mth::comp)> mth::differentiate(const std::function<mth::comp(mth::comp)> &function) {
 
-    auto avgGradient = [&] (comp a, comp b) {
+    // Captured by value so the derivative outlives this call
+    auto avgGradient = [function] (comp a, comp b) {
 
         auto dy = function(b) - function(a);
         auto dx = b - a;
@@ -159,7 +498,7 @@ std::function<mth::comp(mth::comp)> mth::differentiate(const std::function<mth::
         return dy / dx;
     };
 
-    return [&] (comp x) {
+    return [avgGradient] (comp x) {
 
         auto gradientApprox = [&] (mth::comp dx) {
 
@@ -169,4 +508,3 @@ std::function<mth::comp(mth::comp)> mth::differentiate(const std::function<mth::
         return limit(gradientApprox, comp(0));
     };
 }
-
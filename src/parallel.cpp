@@ -0,0 +1,156 @@
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+#include <mth/mth.h>
+
+#include <mth/parallel.h>
+
+// Set on pool workers so nested parallel loops run serially instead of waiting on themselves
+static thread_local bool insideWorker = false;
+
+mth::ThreadPool::ThreadPool(size_t threads) {
+
+    // hardware_concurrency may report zero when it can't be determined
+    if (threads == 0) threads = 1;
+
+    for (size_t i = 0; i < threads; i++) {
+
+        workers.emplace_back([this] { work(); });
+    }
+}
+
+mth::ThreadPool::~ThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    available.notify_all();
+
+    for (auto &worker : workers) {
+
+        worker.join();
+    }
+}
+
+void mth::ThreadPool::work() {
+
+    insideWorker = true;
+
+    while (true) {
+
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+            if (tasks.empty()) return;
+
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+    }
+}
+
+size_t mth::ThreadPool::size() const {
+
+    return workers.size();
+}
+
+void mth::ThreadPool::parallelFor(size_t count, const std::function<void(size_t)> &body) {
+
+    if (count == 0) return;
+
+    if (insideWorker || count == 1 || workers.empty()) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            body(i);
+        }
+
+        return;
+    }
+
+    // Indices are claimed dynamically so uneven costs balance across threads
+    std::atomic<size_t> next {0};
+
+    std::mutex doneMutex;
+    std::condition_variable done;
+    size_t running = 0;
+
+    std::exception_ptr error;
+
+    auto run = [&] {
+
+        for (auto i = next++; i < count; i = next++) {
+
+            try {
+
+                body(i);
+
+            } catch (...) {
+
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    };
+
+    auto helpers = std::min(count - 1, workers.size());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (size_t i = 0; i < helpers; i++) {
+
+            running++;
+
+            tasks.push([&] {
+
+                run();
+
+                std::lock_guard<std::mutex> lock(doneMutex);
+
+                if (--running == 0) done.notify_one();
+            });
+        }
+    }
+
+    available.notify_all();
+
+    run();
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&] { return running == 0; });
+
+    if (error) std::rethrow_exception(error);
+}
+
+mth::ThreadPool &mth::ThreadPool::shared() {
+
+    static ThreadPool pool;
+
+    return pool;
+}
+
+void mth::forEachIndex(size_t count, const std::function<void(size_t)> &body, mth::Execution execution) {
+
+    if (execution == Execution::Parallel) {
+
+        ThreadPool::shared().parallelFor(count, body);
+
+    } else {
+
+        for (size_t i = 0; i < count; i++) {
+
+            body(i);
+        }
+    }
+}
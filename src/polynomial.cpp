@@ -1,7 +1,11 @@
 
+#include <algorithm>
+#include <cmath>
+
 #include <mth/mth.h>
 
 #include <mth/polynomial.h>
+#include <mth/fft.h>
 
 mth::ComplexSolutions::ComplexSolutions(std::unordered_set<mth::comp> finiteSet) noexcept
     :solutionSet(finiteSet) {}
@@ -593,3 +597,114 @@ mth::Polynomial mth::integrate(const mth::Polynomial &polynomial) {
     return result;
 }
 
+// Below this many coefficients shifts are done directly
+constexpr size_t directShift = 64;
+
+// Returns value * 2^exponent, exact unless the result over or underflows
+mth::comp scaleByPowerOfTwo(const mth::comp &value, int exponent) {
+
+    return mth::comp::fromCartesian(std::ldexp(value.real(), exponent), std::ldexp(value.imag(), exponent));
+}
+
+// Returns the binary exponent of the larger component of value, so value * 2^-exponent is below one in size
+int binaryExponent(const mth::comp &value) {
+
+    auto exponent = 0;
+
+    std::frexp(std::max(std::abs(value.real()), std::abs(value.imag())), &exponent);
+
+    return exponent;
+}
+
+// Returns the coefficients of p(z + offset) given those of p
+std::vector<mth::comp> shiftCoeffs(const std::vector<mth::comp> &coeffs, const mth::comp &offset) {
+
+    auto n = coeffs.size();
+
+    if (n <= directShift) {
+
+        // Repeated synthetic division by (z - offset), as in Horner's scheme, in O(n^2)
+        auto result = coeffs;
+
+        for (size_t i = 0; i + 1 < n; i++) {
+
+            for (auto j = n - 1; j-- > i;) {
+
+                result[j] += offset * result[j + 1];
+            }
+        }
+
+        return result;
+    }
+
+    // p = low + z^half high, so p(z + offset) = low(z + offset) + (z + offset)^half high(z + offset)
+    auto half = n / 2;
+
+    std::vector<mth::comp> low(coeffs.begin(), coeffs.begin() + half);
+    std::vector<mth::comp> high(coeffs.begin() + half, coeffs.end());
+
+    auto result = shiftCoeffs(low, offset);
+
+    // Binomial coefficients of (z + offset)^half from the top, using C(h, j - 1) = C(h, j) j / (h - j + 1)
+    // These pass 2^1024 once half is past a thousand or so, so each is kept as a mantissa and binary exponent
+    std::vector<mth::comp> power(half + 1);
+    std::vector<int> exponents(half + 1);
+
+    power[half] = mth::comp{1};
+
+    for (auto j = half; j > 0; j--) {
+
+        auto value = power[j] * offset * (static_cast<double>(j) / static_cast<double>(half - j + 1));
+        auto exponent = binaryExponent(value);
+
+        power[j - 1] = scaleByPowerOfTwo(value, -exponent);
+        exponents[j - 1] = exponents[j] + exponent;
+    }
+
+    // Scale both factors to a largest entry near one; entries that underflow are below the FFT's rounding anyway
+    auto powerExponent = *std::max_element(exponents.begin(), exponents.end());
+
+    for (size_t j = 0; j <= half; j++) {
+
+        power[j] = scaleByPowerOfTwo(power[j], exponents[j] - powerExponent);
+    }
+
+    auto shifted = shiftCoeffs(high, offset);
+
+    auto highExponent = 0;
+
+    for (auto &coeff : shifted) highExponent = std::max(highExponent, binaryExponent(coeff));
+    for (auto &coeff : shifted) coeff = scaleByPowerOfTwo(coeff, -highExponent);
+
+    auto product = mth::convolve(power, shifted);
+
+    result.resize(n);
+
+    for (size_t i = 0; i < n; i++) {
+
+        result[i] += scaleByPowerOfTwo(product[i], powerExponent + highExponent);
+    }
+
+    return result;
+}
+
+mth::Polynomial mth::shift(const mth::Polynomial &polynomial, const mth::comp &offset) {
+
+    if (polynomial.getDegree().isInfinite()) return Polynomial();
+
+    return Polynomial::fromCoeffs(shiftCoeffs(polynomial.getCoeffs(), offset));
+}
+
+mth::Polynomial mth::dilate(const mth::Polynomial &polynomial, const mth::comp &factor) {
+
+    auto coeffs = polynomial.getCoeffs();
+    auto power = comp{1};
+
+    for (auto &coeff : coeffs) {
+
+        coeff *= power;
+        power *= factor;
+    }
+
+    return Polynomial::fromCoeffs(coeffs);
+}
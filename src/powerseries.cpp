@@ -1,12 +1,291 @@
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
 #include <mth/mth.h>
 
 #include <mth/powerseries.h>
+#include <mth/cache.h>
+#include <mth/fft.h>
 
 #include <mth/numeric.h>
 
+struct mth::PowerSeries::Coefficients {
+
+    // Exactly one of these generates the coefficients
+    std::function<comp(size_t)> generator;
+    std::function<std::vector<comp>(size_t)> truncation;
+
+    tcache<comp> values;
+
+    // Held while extending values; reads of published coefficients don't take it
+    std::mutex mutex;
+
+    // Returns the coefficient at index, generating any missing ones first
+    // Must be called with mutex held, so generators can read earlier coefficients through it
+    comp at(size_t index) {
+
+        if (index >= values.size()) extend(index);
+
+        return values[index];
+    }
+
+    // Must be called with mutex held
+    void extend(size_t index) {
+
+        auto size = values.size();
+
+        if (generator) {
+
+            for (auto i = size; i <= index; i++) {
+
+                values.push(generator(i));
+            }
+
+            return;
+        }
+
+        // Grow geometrically so a run of increasing indices costs a constant number of truncations per doubling
+        constexpr size_t firstBlock = 16;
+
+        auto count = std::max({index + 1, 2 * size, firstBlock});
+        auto block = truncation(count);
+
+        for (auto i = size; i < count; i++) {
+
+            values.push(i < block.size() ? block[i] : comp{0});
+        }
+    }
+};
+
+// Below this many coefficients direct recurrences beat Newton iteration
+constexpr size_t newtonThreshold = 64;
+
+// Returns the first count coefficients of the product of two truncations
+std::vector<mth::comp> multiplyTruncated(std::vector<mth::comp> lhs, std::vector<mth::comp> rhs, size_t count) {
+
+    // Coefficients past count can't affect the result
+    if (lhs.size() > count) lhs.resize(count);
+    if (rhs.size() > count) rhs.resize(count);
+
+    auto result = mth::convolve(lhs, rhs);
+
+    result.resize(count);
+
+    return result;
+}
+
+// Returns the first count coefficients of lhs / rhs directly, where rhs[0] is non-zero
+std::vector<mth::comp> divideDirect(const std::vector<mth::comp> &lhs, const std::vector<mth::comp> &rhs, size_t count) {
+
+    std::vector<mth::comp> result(count);
+
+    auto inverseConstant = rhs[0].inverse();
+
+    // From lhs = rhs * result, q_n = (a_n - b_1 q_(n - 1) - ... - b_n q_0) / b_0
+    for (size_t n = 0; n < count; n++) {
+
+        auto value = n < lhs.size() ? lhs[n] : mth::comp{0};
+
+        for (size_t k = 1; k <= n && k < rhs.size(); k++) {
+
+            value -= rhs[k] * result[n - k];
+        }
+
+        result[n] = value * inverseConstant;
+    }
+
+    return result;
+}
+
+// Returns the first count coefficients of 1 / series, where series[0] is non-zero
+std::vector<mth::comp> reciprocalTruncated(const std::vector<mth::comp> &series, size_t count) {
+
+    if (count <= newtonThreshold) return divideDirect({mth::comp{1}}, series, count);
+
+    // Newton's iteration g -> g (2 - f g) doubles the number of correct coefficients each step
+    std::vector<mth::comp> result {series[0].inverse()};
+
+    for (size_t size = 1; size < count;) {
+
+        size = std::min(2 * size, count);
+
+        auto error = multiplyTruncated(series, result, size);
+
+        for (auto &value : error) value = -value;
+
+        error[0] += mth::comp{2};
+
+        result = multiplyTruncated(result, error, size);
+    }
+
+    return result;
+}
+
+// Returns the first count coefficients of lhs / rhs, where rhs[0] is non-zero
+std::vector<mth::comp> divideTruncated(const std::vector<mth::comp> &lhs, const std::vector<mth::comp> &rhs, size_t count) {
+
+    if (count <= newtonThreshold) return divideDirect(lhs, rhs, count);
+
+    return multiplyTruncated(lhs, reciprocalTruncated(rhs, count), count);
+}
+
+// Returns the first count coefficients of log(series), where series[0] is non-zero
+std::vector<mth::comp> logTruncated(const std::vector<mth::comp> &series, size_t count) {
+
+    using mth::log;
+
+    // log(f) = log(f_0) + integral of f' / f
+    std::vector<mth::comp> derivative(count > 1 ? count - 1 : 0);
+
+    for (size_t n = 0; n + 1 < count; n++) {
+
+        derivative[n] = n + 1 < series.size() ? series[n + 1] * static_cast<double>(n + 1) : mth::comp{0};
+    }
+
+    auto quotient = divideTruncated(derivative, series, derivative.size());
+
+    std::vector<mth::comp> result(count);
+
+    result[0] = log(series[0]);
+
+    for (size_t n = 1; n < count; n++) {
+
+        result[n] = quotient[n - 1] / static_cast<double>(n);
+    }
+
+    return result;
+}
+
+// Returns the first count coefficients of exp(series)
+std::vector<mth::comp> expTruncated(const std::vector<mth::comp> &series, size_t count) {
+
+    using mth::exp;
+
+    auto constant = exp(series[0]);
+
+    std::vector<mth::comp> result;
+
+    if (count <= newtonThreshold) {
+
+        // From g' = f' g, n g_n = sum_k k f_k g_(n - k)
+        result.assign(count, mth::comp{0});
+        result[0] = constant;
+
+        for (size_t n = 1; n < count; n++) {
+
+            auto value = mth::comp{0};
+
+            for (size_t k = 1; k <= n && k < series.size(); k++) {
+
+                value += static_cast<double>(k) * series[k] * result[n - k];
+            }
+
+            result[n] = value / static_cast<double>(n);
+        }
+
+        return result;
+    }
+
+    // Newton's iteration g -> g (1 + f - log(g)) on f without its constant, scaled by exp(f_0) afterwards
+    result = {mth::comp{1}};
+
+    for (size_t size = 1; size < count;) {
+
+        size = std::min(2 * size, count);
+
+        auto correction = logTruncated(result, size);
+
+        for (size_t n = 0; n < size; n++) {
+
+            auto coeff = n > 0 && n < series.size() ? series[n] : mth::comp{0};
+
+            correction[n] = coeff - correction[n];
+        }
+
+        correction[0] += mth::comp{1};
+
+        result = multiplyTruncated(result, correction, size);
+    }
+
+    for (auto &value : result) value *= constant;
+
+    return result;
+}
+
+// Returns the first count coefficients of sqrt(series), where series[0] is non-zero
+std::vector<mth::comp> sqrtTruncated(const std::vector<mth::comp> &series, size_t count) {
+
+    using mth::sqrt;
+
+    std::vector<mth::comp> result {sqrt(series[0])};
+
+    if (count <= newtonThreshold) {
+
+        // From g^2 = f, 2 g_0 g_n = f_n - sum_(0 < k < n) g_k g_(n - k)
+        auto inverseDouble = (2.0 * result[0]).inverse();
+
+        for (size_t n = 1; n < count; n++) {
+
+            auto value = n < series.size() ? series[n] : mth::comp{0};
+
+            for (size_t k = 1; k < n; k++) {
+
+                value -= result[k] * result[n - k];
+            }
+
+            result.push_back(value * inverseDouble);
+        }
+
+        return result;
+    }
+
+    // Newton's iteration g -> (g + f / g) / 2
+    for (size_t size = 1; size < count;) {
+
+        size = std::min(2 * size, count);
+
+        auto quotient = divideTruncated(series, result, size);
+
+        result.resize(size);
+
+        for (size_t n = 0; n < size; n++) {
+
+            result[n] = 0.5 * (result[n] + quotient[n]);
+        }
+    }
+
+    return result;
+}
+
+// Throws if a series has a zero constant coefficient, for functions that need to divide by it
+void requireConstant(const mth::PowerSeries &series, const char *message) {
+
+    if (series.getCoeff(0) == mth::comp{0}) throw std::invalid_argument(message);
+}
+
+mth::PowerSeries::PowerSeries()
+    :PowerSeries([] (size_t) { return comp(0); }) {}
+
 mth::PowerSeries::PowerSeries(std::function<comp(size_t)> generatingFunction)
-    :generatingFunction(generatingFunction) {}
+    :coefficients(std::make_shared<Coefficients>()) {
+
+    coefficients->generator = std::move(generatingFunction);
+}
+
+mth::PowerSeries mth::PowerSeries::fromTruncation(std::function<std::vector<comp>(size_t)> truncation) {
+
+    PowerSeries result;
+
+    result.coefficients = std::make_shared<Coefficients>();
+    result.coefficients->truncation = std::move(truncation);
+
+    return result;
+}
 
 mth::PowerSeries mth::PowerSeries::finite(const mth::Polynomial &equivalent) {
 
@@ -16,7 +295,7 @@ mth::PowerSeries mth::PowerSeries::finite(const mth::Polynomial &equivalent) {
 
     const auto degreeValue = degree.getValue();
 
-    auto gen = [&] (size_t n) {
+    auto gen = [equivalent, degreeValue] (size_t n) {
 
         if (n > degreeValue) return comp(0);
 
@@ -31,27 +310,169 @@ mth::PowerSeries mth::PowerSeries::finite(const mth::Polynomial &equivalent) {
     return result;
 }
 
-mth::PowerSeries mth::PowerSeries::recursive(std::function<comp(comp)> recursion, const comp &constant) {
+mth::PowerSeries mth::PowerSeries::taylor(const std::function<mth::comp(mth::comp)> &f, const mth::comp &centre, double radius,
+                                          size_t order, mth::Execution execution) {
 
-    auto generatingFunction = [&] (size_t index) {
+    if (order == 0) return PowerSeries();
 
-        auto accumulate = constant;
+    // Twice as many samples as coefficients, so aliasing from later coefficients is damped by radius^(2 order)
+    size_t samples = 1;
 
-        while (index > 0) {
+    while (samples < 2 * order) samples <<= 1;
 
-            accumulate = recursion(accumulate);
-            index--;
-        }
+    std::vector<comp> values(samples);
+
+    forEachIndex(samples, [&] (size_t j) {
+
+        auto angle = tau<double> * static_cast<double>(j) / static_cast<double>(samples);
+
+        values[j] = f(centre + comp::fromPolar(radius, angle));
 
-        return accumulate;
+    }, execution);
+
+    // a_k = (1 / N) sum_j f(centre + r w^j) w^(-jk) / r^k with w = exp(2 pi i / N)
+    fft(values);
+
+    std::vector<comp> coeffs(order);
+
+    auto scale = 1.0 / static_cast<double>(samples);
+
+    for (size_t k = 0; k < order; k++) {
+
+        coeffs[k] = values[k] * scale;
+        scale /= radius;
+    }
+
+    return PowerSeries::finite(Polynomial::fromCoeffs(coeffs));
+}
+
+mth::PowerSeries mth::PowerSeries::fromRatios(std::vector<comp> initial, std::function<comp(size_t)> ratio) {
+
+    PowerSeries result;
+
+    result.coefficients = std::make_shared<Coefficients>();
+
+    // The generator lives in the cache it reads, so a raw pointer shares its lifetime without a cycle
+    auto cache = result.coefficients.get();
+    auto step = initial.size();
+
+    result.coefficients->generator = [cache, initial, ratio, step] (size_t index) {
+
+        if (index < step) return initial[index];
+
+        // The cache generates coefficients in order with its mutex held, so a_(n - step) is already there
+        return ratio(index) * cache->at(index - step);
     };
 
-    return PowerSeries(generatingFunction);
+    return result;
+}
+
+mth::PowerSeries mth::PowerSeries::exponential() {
+
+    return fromRatios({1.0}, [] (size_t n) { return comp(1.0 / static_cast<double>(n)); });
+}
+
+mth::PowerSeries mth::PowerSeries::sine() {
+
+    return fromRatios({0.0, 1.0}, [] (size_t n) { return comp(-1.0 / (static_cast<double>(n) * static_cast<double>(n - 1))); });
+}
+
+mth::PowerSeries mth::PowerSeries::cosine() {
+
+    return fromRatios({1.0, 0.0}, [] (size_t n) { return comp(-1.0 / (static_cast<double>(n) * static_cast<double>(n - 1))); });
+}
+
+mth::PowerSeries mth::PowerSeries::logarithm() {
+
+    // (-1)^(n + 1) / n is exact as it stands
+    return PowerSeries([] (size_t index) {
+
+        if (index == 0) return comp{0};
+
+        return comp((index % 2 == 1 ? 1.0 : -1.0) / static_cast<double>(index));
+    });
+}
+
+mth::PowerSeries mth::PowerSeries::arctangent() {
+
+    return PowerSeries([] (size_t index) {
+
+        if (index % 2 == 0) return comp{0};
+
+        return comp((index % 4 == 1 ? 1.0 : -1.0) / static_cast<double>(index));
+    });
+}
+
+mth::PowerSeries mth::PowerSeries::binomial(const mth::comp &exponent) {
+
+    // (exponent choose n) = (exponent choose n - 1) (exponent - n + 1) / n
+    return fromRatios({1.0}, [exponent] (size_t n) {
+
+        return (exponent - comp(static_cast<double>(n - 1))) / static_cast<double>(n);
+    });
+}
+
+// Wrap the memoized terms of a recursive series as coefficients
+mth::PowerSeries fromTerms(const mth::Series &terms) {
+
+    return mth::PowerSeries([terms] (size_t index) {
+
+        return terms.getTerm(index);
+    });
+}
+
+mth::PowerSeries mth::PowerSeries::recursive(std::function<mth::comp(mth::comp)> recursion, const mth::comp &constant) {
+
+    return fromTerms(Series::recursive(recursion, constant));
+}
+
+mth::PowerSeries mth::PowerSeries::recursive(std::function<mth::comp(size_t, mth::comp)> recursion, const mth::comp &constant) {
+
+    return fromTerms(Series::recursive(recursion, constant));
+}
+
+mth::PowerSeries mth::PowerSeries::recursive(std::function<mth::comp(size_t, const std::vector<mth::comp> &)> recursion, std::vector<mth::comp> initial) {
+
+    return fromTerms(Series::recursive(recursion, initial));
 }
 
 mth::comp mth::PowerSeries::getCoeff(size_t index) const {
 
-    return generatingFunction(index);
+    auto &c = *coefficients;
+
+    // Published coefficients are read without locking
+    if (index < c.values.size()) return c.values[index];
+
+    std::lock_guard<std::mutex> lock(c.mutex);
+
+    // Another thread may have extended the cache while we waited
+    if (index >= c.values.size()) c.extend(index);
+
+    return c.values[index];
+}
+
+std::vector<mth::comp> mth::PowerSeries::getCoeffs(size_t count) const {
+
+    std::vector<comp> result;
+
+    if (count == 0) return result;
+
+    // Extend once, then read the published prefix
+    getCoeff(count - 1);
+
+    result.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+
+        result.push_back(coefficients->values[i]);
+    }
+
+    return result;
+}
+
+mth::Polynomial mth::PowerSeries::truncate(size_t order) const {
+
+    return Polynomial::fromCoeffs(getCoeffs(order + 1));
 }
 
 mth::Series mth::PowerSeries::series(const mth::comp &z) const {
@@ -77,18 +498,220 @@ mth::Series mth::PowerSeries::series(const mth::comp &z) const {
 
     } else {
 
-        return Series([&] (size_t index) {
+        // Powers of z shared by copies of the series, each computed once from the one before
+        struct Powers {
+
+            tcache<comp> values;
+            std::mutex mutex;
+        };
+
+        auto powers = std::make_shared<Powers>();
+
+        powers->values.push(comp{1});
+
+        // Copies share the coefficient cache, so capturing by value keeps it alive with the series
+        auto coefficients = *this;
+
+        return Series([coefficients, powers, z] (size_t index) {
+
+            if (index >= powers->values.size()) {
+
+                std::lock_guard<std::mutex> lock(powers->mutex);
+
+                for (auto n = powers->values.size(); n <= index; n++) {
 
-            using std::pow;
-            return generatingFunction(index) * pow(z, index);
+                    powers->values.push(powers->values[n - 1] * z);
+                }
+            }
+
+            return coefficients.getCoeff(index) * powers->values[index];
 
         });
     }
 }
 
+double mth::PowerSeries::radius(size_t count, mth::RadiusMethod method) const {
+
+    constexpr auto infinity = std::numeric_limits<double>::infinity();
+
+    if (isTrivial) return infinity;
+
+    auto coeffs = getCoeffs(count);
+
+    // Indices and magnitudes of the non-zero coefficients, so series with gaps like cos(z) still work
+    std::vector<double> indices;
+    std::vector<double> magnitudes;
+
+    for (size_t n = 0; n < coeffs.size(); n++) {
+
+        auto magnitude = coeffs[n].abs();
+
+        if (magnitude > 0.0 && std::isfinite(magnitude)) {
+
+            indices.push_back(static_cast<double>(n));
+            magnitudes.push_back(magnitude);
+        }
+    }
+
+    if (indices.size() < 2) return infinity;
+
+    // Only the later coefficients reflect the asymptotic behaviour
+    auto first = indices.size() / 2;
+
+    switch (method) {
+
+        case RadiusMethod::Root: {
+
+            // The root test takes the limit superior, approximated by the largest late value
+            auto largest = 0.0;
+
+            for (auto k = std::max(first, size_t{1}); k < indices.size(); k++) {
+
+                largest = std::max(largest, std::pow(magnitudes[k], 1.0 / indices[k]));
+            }
+
+            return largest == 0.0 ? infinity : 1.0 / largest;
+        }
+
+        case RadiusMethod::Ratio: {
+
+            auto last = indices.size() - 1;
+            auto ratio = std::pow(magnitudes[last] / magnitudes[last - 1], 1.0 / (indices[last] - indices[last - 1]));
+
+            return ratio == 0.0 ? infinity : 1.0 / ratio;
+        }
+
+        default: break;
+    }
+
+    // Least squares fit of the ratio per step r against 1 / n, whose intercept is 1 / radius
+    auto sumX = 0.0;
+    auto sumY = 0.0;
+    auto sumXX = 0.0;
+    auto sumXY = 0.0;
+    auto points = 0.0;
+
+    for (auto k = std::max(first, size_t{1}); k < indices.size(); k++) {
+
+        auto x = 1.0 / indices[k];
+        auto y = std::pow(magnitudes[k] / magnitudes[k - 1], 1.0 / (indices[k] - indices[k - 1]));
+
+        sumX += x;
+        sumY += y;
+        sumXX += x * x;
+        sumXY += x * y;
+        points += 1.0;
+    }
+
+    auto denom = points * sumXX - sumX * sumX;
+
+    auto intercept = points < 2.0 || denom == 0.0 ? sumY / points : (sumY * sumXX - sumX * sumXY) / denom;
+
+    return intercept <= 0.0 ? infinity : 1.0 / intercept;
+}
+
+mth::TruncationEstimate mth::PowerSeries::termsFor(const mth::comp &z, double tolerance, size_t count, size_t maxTerms) const {
+
+    TruncationEstimate result;
+
+    result.radius = radius(count);
+
+    if (isTrivial) {
+
+        auto degree = trivialSeries.getDegree();
+
+        result.terms = degree.isInfinite() ? 0 : degree.getValue() + 1;
+        result.converges = true;
+
+        return result;
+    }
+
+    auto distance = z.abs();
+
+    if (distance == 0.0) {
+
+        result.terms = 1;
+        result.converges = true;
+
+        return result;
+    }
+
+    if (distance >= result.radius) {
+
+        result.terms = maxTerms;
+
+        return result;
+    }
+
+    auto coeffs = getCoeffs(count);
+
+    // Bound the coefficients by scale * r^-n for an r between |z| and the radius, then sum the geometric tail
+    // Using the midpoint rather than the radius itself leaves room for power law factors in the coefficients
+    auto rate = std::isinf(result.radius) ? 2.0 * distance + 1.0 : 0.5 * (distance + result.radius);
+    auto logScale = -std::numeric_limits<double>::infinity();
+
+    for (size_t n = 0; n < coeffs.size(); n++) {
+
+        auto magnitude = coeffs[n].abs();
+
+        if (magnitude > 0.0) logScale = std::max(logScale, std::log(magnitude) + n * std::log(rate));
+    }
+
+    auto q = distance / rate;
+
+    // Smallest N with scale * q^N / (1 - q) <= tolerance
+    auto needed = (std::log(tolerance * (1.0 - q)) - logScale) / std::log(q);
+    auto terms = std::isfinite(needed) ? std::max(1.0, std::ceil(needed)) : 1.0;
+
+    if (terms > static_cast<double>(maxTerms)) {
+
+        result.terms = maxTerms;
+
+        return result;
+    }
+
+    result.terms = static_cast<size_t>(terms);
+    result.converges = true;
+
+    return result;
+}
+
+// Evaluate the polynomial with the given coefficients at z
+mth::comp horner(const std::vector<mth::comp> &coeffs, const mth::comp &z) {
+
+    auto result = mth::comp{0};
+
+    for (auto coeff = coeffs.rbegin(); coeff != coeffs.rend(); coeff++) {
+
+        result = result * z + *coeff;
+    }
+
+    return result;
+}
+
+mth::comp mth::PowerSeries::value(const mth::comp &z, size_t order) const {
+
+    return horner(getCoeffs(order + 1), z);
+}
+
+std::vector<mth::comp> mth::PowerSeries::values(const std::vector<mth::comp> &points, size_t order, mth::Execution execution) const {
+
+    auto coeffs = getCoeffs(order + 1);
+
+    std::vector<comp> result(points.size());
+
+    forEachIndex(points.size(), [&] (size_t i) {
+
+        result[i] = horner(coeffs, points[i]);
+
+    }, execution);
+
+    return result;
+}
+
 mth::PowerSeries mth::differentiate(const mth::PowerSeries &series) {
 
-    auto generatingFunction = [&] (size_t index) {
+    auto generatingFunction = [series] (size_t index) {
 
         auto c = series.getCoeff(index + 1);
 
@@ -100,11 +723,11 @@ mth::PowerSeries mth::differentiate(const mth::PowerSeries &series) {
 
 mth::PowerSeries mth::integrate(const mth::PowerSeries &series) {
 
-    auto generatingFunction = [&] (size_t index) {
+    auto generatingFunction = [series] (size_t index) {
 
         if (index == 0) return comp{0};
 
-        auto c = series.getCoeff(index);
+        auto c = series.getCoeff(index - 1);
 
         return c / comp{static_cast<double>(index)};
     };
@@ -112,3 +735,169 @@ mth::PowerSeries mth::integrate(const mth::PowerSeries &series) {
     return PowerSeries(generatingFunction);
 }
 
+mth::PowerSeries mth::shift(const mth::PowerSeries &series, const mth::comp &offset, size_t order) {
+
+    return PowerSeries::finite(shift(series.truncate(order), offset));
+}
+
+mth::PowerSeries mth::dilate(const mth::PowerSeries &series, const mth::comp &factor) {
+
+    // Powers of the factor come from the shared table behind series(factor)
+    auto terms = series.series(factor);
+
+    return PowerSeries([terms] (size_t index) {
+
+        return terms.getTerm(index);
+    });
+}
+
+mth::PowerSeries mth::operator+(const mth::PowerSeries &lhs, const mth::PowerSeries &rhs) {
+
+    if (lhs.isTrivial && rhs.isTrivial) return PowerSeries::finite(lhs.trivialSeries + rhs.trivialSeries);
+
+    return PowerSeries([lhs, rhs] (size_t index) {
+
+        return lhs.getCoeff(index) + rhs.getCoeff(index);
+    });
+}
+
+mth::PowerSeries mth::operator-(const mth::PowerSeries &rhs) {
+
+    return rhs * comp{-1};
+}
+
+mth::PowerSeries mth::operator-(const mth::PowerSeries &lhs, const mth::PowerSeries &rhs) {
+
+    return lhs + (-rhs);
+}
+
+mth::PowerSeries mth::operator*(const mth::PowerSeries &lhs, const mth::comp &rhs) {
+
+    if (lhs.isTrivial) return PowerSeries::finite(lhs.trivialSeries * rhs);
+
+    return PowerSeries([lhs, rhs] (size_t index) {
+
+        return lhs.getCoeff(index) * rhs;
+    });
+}
+
+mth::PowerSeries mth::operator*(const mth::comp &lhs, const mth::PowerSeries &rhs) {
+
+    return rhs * lhs;
+}
+
+mth::PowerSeries mth::operator*(const mth::PowerSeries &lhs, const mth::PowerSeries &rhs) {
+
+    if (lhs.isTrivial && rhs.isTrivial) return PowerSeries::finite(lhs.trivialSeries * rhs.trivialSeries);
+
+    return PowerSeries::fromTruncation([lhs, rhs] (size_t count) {
+
+        return multiplyTruncated(lhs.getCoeffs(count), rhs.getCoeffs(count), count);
+    });
+}
+
+mth::PowerSeries mth::operator/(const mth::PowerSeries &lhs, const mth::comp &rhs) {
+
+    return lhs * rhs.inverse();
+}
+
+mth::PowerSeries mth::operator/(const mth::PowerSeries &lhs, const mth::PowerSeries &rhs) {
+
+    requireConstant(rhs, "mth::exception: cannot divide by a power series with zero constant coefficient");
+
+    return PowerSeries::fromTruncation([lhs, rhs] (size_t count) {
+
+        return divideTruncated(lhs.getCoeffs(count), rhs.getCoeffs(count), count);
+    });
+}
+
+mth::PowerSeries mth::reciprocal(const mth::PowerSeries &series) {
+
+    requireConstant(series, "mth::exception: cannot take the reciprocal of a power series with zero constant coefficient");
+
+    return PowerSeries::fromTruncation([series] (size_t count) {
+
+        return reciprocalTruncated(series.getCoeffs(count), count);
+    });
+}
+
+mth::PowerSeries mth::compose(const mth::PowerSeries &outer, const mth::PowerSeries &inner) {
+
+    if (inner.getCoeff(0) != comp{0}) {
+
+        throw std::invalid_argument("mth::exception: cannot compose with an inner power series with non-zero constant coefficient");
+    }
+
+    return PowerSeries::fromTruncation([outer, inner] (size_t count) {
+
+        auto outerCoeffs = outer.getCoeffs(count);
+        auto innerCoeffs = inner.getCoeffs(count);
+
+        // Baby step giant step: with m around sqrt(count), outer splits into blocks P_j of m coefficients, so
+        // outer(inner) = sum_j P_j(inner) inner^(jm), and only the powers inner^0 to inner^m need products
+        auto step = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+        std::vector<std::vector<comp>> powers {{comp{1}}};
+
+        for (size_t k = 1; k <= step; k++) {
+
+            powers.push_back(multiplyTruncated(powers.back(), innerCoeffs, count));
+        }
+
+        auto blocks = (count + step - 1) / step;
+
+        std::vector<comp> result;
+
+        // Horner's scheme in inner^m over the blocks, where inner^(jm) vanishes below z^(jm) so block j
+        // only needs its first count - jm coefficients
+        for (auto j = blocks; j-- > 0;) {
+
+            auto size = count - j * step;
+
+            if (!result.empty()) result = multiplyTruncated(result, powers[step], size);
+
+            result.resize(size);
+
+            for (size_t k = 0; k < step && j * step + k < count; k++) {
+
+                auto coeff = outerCoeffs[j * step + k];
+                auto &power = powers[k];
+
+                for (size_t n = k; n < size && n < power.size(); n++) {
+
+                    result[n] += coeff * power[n];
+                }
+            }
+        }
+
+        return result;
+    });
+}
+
+mth::PowerSeries mth::exp(const mth::PowerSeries &series) {
+
+    return PowerSeries::fromTruncation([series] (size_t count) {
+
+        return expTruncated(series.getCoeffs(count), count);
+    });
+}
+
+mth::PowerSeries mth::log(const mth::PowerSeries &series) {
+
+    requireConstant(series, "mth::exception: cannot take the log of a power series with zero constant coefficient");
+
+    return PowerSeries::fromTruncation([series] (size_t count) {
+
+        return logTruncated(series.getCoeffs(count), count);
+    });
+}
+
+mth::PowerSeries mth::sqrt(const mth::PowerSeries &series) {
+
+    requireConstant(series, "mth::exception: cannot take the sqrt of a power series with zero constant coefficient");
+
+    return PowerSeries::fromTruncation([series] (size_t count) {
+
+        return sqrtTruncated(series.getCoeffs(count), count);
+    });
+}
@@ -0,0 +1,341 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mth/mth.h>
+
+#include <mth/rational.h>
+
+mth::RationalFunction::RationalFunction(mth::Polynomial numerator, mth::Polynomial denominator)
+    :numerator(std::move(numerator)), denominator(std::move(denominator)) {
+
+    numeratorDegree = this->numerator.getDegree();
+    denominatorDegree = this->denominator.getDegree();
+
+    if (denominatorDegree.isInfinite()) {
+
+        throw std::invalid_argument("mth::exception: rational function with a zero denominator");
+    }
+}
+
+const mth::Polynomial &mth::RationalFunction::getNumerator() const {
+
+    return numerator;
+}
+
+const mth::Polynomial &mth::RationalFunction::getDenominator() const {
+
+    return denominator;
+}
+
+// Returns sum_k coeffs[k] z^k for k up to degree by Horner's scheme
+// With reversed set, returns sum_k coeffs[k] z^(degree - k) instead
+mth::comp hornerDegree(const std::vector<mth::comp> &coeffs, size_t degree, const mth::comp &z, bool reversed) {
+
+    auto result = mth::comp{0};
+
+    for (size_t i = 0; i <= degree; i++) {
+
+        result = result * z + coeffs[reversed ? i : degree - i];
+    }
+
+    return result;
+}
+
+mth::comp mth::RationalFunction::value(const mth::comp &z) const {
+
+    if (numeratorDegree.isInfinite()) return comp{0};
+
+    auto L = numeratorDegree.getValue();
+    auto M = denominatorDegree.getValue();
+
+    if (z.absSqr() <= 1.0) {
+
+        return hornerDegree(numerator.getCoeffs(), L, z, false) / hornerDegree(denominator.getCoeffs(), M, z, false);
+    }
+
+    // p(z) / q(z) = z^(L - M) p~(1 / z) / q~(1 / z) with p~ and q~ the reversed polynomials
+    auto w = 1.0 / z;
+
+    auto ratio = hornerDegree(numerator.getCoeffs(), L, w, true) / hornerDegree(denominator.getCoeffs(), M, w, true);
+
+    if (L >= M) return ratio * pow(z, L - M);
+
+    return ratio * pow(w, M - L);
+}
+
+mth::comp mth::RationalFunction::operator()(const mth::comp &z) const {
+
+    return value(z);
+}
+
+mth::RationalFunction::operator std::function<mth::comp(mth::comp)>() const {
+
+    auto copy = *this;
+
+    return [copy] (comp z) { return copy.value(z); };
+}
+
+// Solve the system with entries matrix[i][j] = toeplitz[size - 1 + i - j] by Levinson recursion
+// Returns false, leaving solution unspecified, if a leading minor is (nearly) singular
+bool levinson(const std::vector<mth::comp> &toeplitz, const std::vector<mth::comp> &rhs, std::vector<mth::comp> &solution) {
+
+    auto size = rhs.size();
+
+    // Entry t_k for k in (-size, size)
+    auto t = [&] (std::ptrdiff_t k) { return toeplitz[static_cast<size_t>(static_cast<std::ptrdiff_t>(size) - 1 + k)]; };
+
+    // Scale for deciding when a pivot has vanished
+    auto scale = 0.0;
+
+    for (auto &entry : toeplitz) scale = std::max(scale, entry.abs());
+
+    auto tolerance = std::sqrt(mth::epsilon<double>);
+
+    if (t(0).abs() <= tolerance * scale) return false;
+
+    // Forward and backward vectors with T f = e_1 and T b = e_n on the leading n by n block
+    std::vector<mth::comp> forward = {1.0 / t(0)};
+    std::vector<mth::comp> backward = forward;
+
+    solution = {rhs[0] / t(0)};
+
+    for (size_t n = 1; n < size; n++) {
+
+        // Residuals of the extended vectors in the new last and first rows
+        auto forwardError = mth::comp{0};
+        auto backwardError = mth::comp{0};
+        auto solutionError = mth::comp{0};
+
+        for (size_t j = 0; j < n; j++) {
+
+            auto offset = static_cast<std::ptrdiff_t>(n - j);
+
+            forwardError += t(offset) * forward[j];
+            solutionError += t(offset) * solution[j];
+            backwardError += t(-static_cast<std::ptrdiff_t>(j + 1)) * backward[j];
+        }
+
+        auto denom = mth::comp{1} - forwardError * backwardError;
+
+        if (denom.abs() <= tolerance) return false;
+
+        std::vector<mth::comp> nextForward(n + 1);
+        std::vector<mth::comp> nextBackward(n + 1);
+
+        for (size_t j = 0; j <= n; j++) {
+
+            auto f = j < n ? forward[j] : mth::comp{0};
+            auto b = j > 0 ? backward[j - 1] : mth::comp{0};
+
+            nextForward[j] = (f - forwardError * b) / denom;
+            nextBackward[j] = (b - backwardError * f) / denom;
+        }
+
+        forward = std::move(nextForward);
+        backward = std::move(nextBackward);
+
+        solution.push_back(mth::comp{0});
+
+        auto correction = rhs[n] - solutionError;
+
+        for (size_t j = 0; j <= n; j++) {
+
+            solution[j] += correction * backward[j];
+        }
+    }
+
+    return true;
+}
+
+// Solve a dense system by Gaussian elimination with partial pivoting
+// Columns without a usable pivot are free, and their unknowns are set to zero
+std::vector<mth::comp> gaussianSolve(std::vector<std::vector<mth::comp>> matrix, std::vector<mth::comp> rhs) {
+
+    auto size = rhs.size();
+
+    auto scale = 0.0;
+
+    for (auto &row : matrix) {
+
+        for (auto &entry : row) scale = std::max(scale, entry.abs());
+    }
+
+    auto tolerance = mth::epsilon<double> * scale * static_cast<double>(size);
+
+    // Row holding the pivot of each column, if any
+    std::vector<size_t> pivotRows(size, size);
+
+    size_t row = 0;
+
+    for (size_t column = 0; column < size && row < size; column++) {
+
+        auto best = row;
+
+        for (auto i = row + 1; i < size; i++) {
+
+            if (matrix[i][column].abs() > matrix[best][column].abs()) best = i;
+        }
+
+        if (matrix[best][column].abs() <= tolerance) continue;
+
+        std::swap(matrix[row], matrix[best]);
+        std::swap(rhs[row], rhs[best]);
+
+        for (auto i = row + 1; i < size; i++) {
+
+            auto factor = matrix[i][column] / matrix[row][column];
+
+            for (auto j = column; j < size; j++) {
+
+                matrix[i][j] -= factor * matrix[row][j];
+            }
+
+            rhs[i] -= factor * rhs[row];
+        }
+
+        pivotRows[column] = row++;
+    }
+
+    std::vector<mth::comp> solution(size);
+
+    for (auto column = size; column-- > 0;) {
+
+        if (pivotRows[column] == size) continue;
+
+        auto &pivotRow = matrix[pivotRows[column]];
+        auto value = rhs[pivotRows[column]];
+
+        for (auto j = column + 1; j < size; j++) {
+
+            value -= pivotRow[j] * solution[j];
+        }
+
+        solution[column] = value / pivotRow[column];
+    }
+
+    return solution;
+}
+
+mth::RationalFunction mth::RationalFunction::pade(const mth::PowerSeries &series, size_t numeratorDegree, size_t denominatorDegree) {
+
+    auto a = series.getCoeffs(numeratorDegree + denominatorDegree + 1);
+
+    // a_k, taken as zero for negative k
+    auto coeff = [&] (std::ptrdiff_t k) { return k < 0 ? comp{0} : a[static_cast<size_t>(k)]; };
+
+    auto L = static_cast<std::ptrdiff_t>(numeratorDegree);
+    auto M = static_cast<std::ptrdiff_t>(denominatorDegree);
+
+    // Denominator 1 + b_1 z + ... + b_M z^M, cancelling the coefficients of z^(L + 1) to z^(L + M) in q * series:
+    // sum_j a_(L + i - j) b_j = -a_(L + i) for i, j from 1 to M
+    std::vector<comp> denominatorCoeffs = {1.0};
+
+    if (M > 0) {
+
+        std::vector<comp> toeplitz;
+        std::vector<comp> rhs;
+
+        for (auto k = -(M - 1); k <= M - 1; k++) toeplitz.push_back(coeff(L + k));
+        for (std::ptrdiff_t i = 1; i <= M; i++) rhs.push_back(-coeff(L + i));
+
+        std::vector<comp> solution;
+
+        if (!levinson(toeplitz, rhs, solution)) {
+
+            std::vector<std::vector<comp>> matrix(denominatorDegree, std::vector<comp>(denominatorDegree));
+
+            for (std::ptrdiff_t i = 0; i < M; i++) {
+
+                for (std::ptrdiff_t j = 0; j < M; j++) {
+
+                    matrix[static_cast<size_t>(i)][static_cast<size_t>(j)] = coeff(L + i - j);
+                }
+            }
+
+            solution = gaussianSolve(std::move(matrix), std::move(rhs));
+        }
+
+        denominatorCoeffs.insert(denominatorCoeffs.end(), solution.begin(), solution.end());
+    }
+
+    // The numerator is the truncation of q * series up to z^L
+    std::vector<comp> numeratorCoeffs(numeratorDegree + 1);
+
+    for (size_t k = 0; k <= numeratorDegree; k++) {
+
+        for (size_t j = 0; j <= std::min(k, denominatorDegree); j++) {
+
+            numeratorCoeffs[k] += denominatorCoeffs[j] * a[k - j];
+        }
+    }
+
+    return RationalFunction(Polynomial::fromCoeffs(numeratorCoeffs), Polynomial::fromCoeffs(denominatorCoeffs));
+}
+
+// Polynomial's operator* treats a zero factor as the identity, which numeric limits currently rely on, so
+// products here check for zero first
+mth::Polynomial product(const mth::Polynomial &lhs, const mth::Polynomial &rhs) {
+
+    if (lhs.getDegree().isInfinite() || rhs.getDegree().isInfinite()) return mth::Polynomial();
+
+    return lhs * rhs;
+}
+
+mth::RationalFunction mth::operator+(const mth::RationalFunction &lhs, const mth::RationalFunction &rhs) {
+
+    return RationalFunction(product(lhs.getNumerator(), rhs.getDenominator()) + product(rhs.getNumerator(), lhs.getDenominator()),
+                            product(lhs.getDenominator(), rhs.getDenominator()));
+}
+
+mth::RationalFunction mth::operator-(const mth::RationalFunction &rhs) {
+
+    return RationalFunction(-rhs.getNumerator(), rhs.getDenominator());
+}
+
+mth::RationalFunction mth::operator-(const mth::RationalFunction &lhs, const mth::RationalFunction &rhs) {
+
+    return lhs + (-rhs);
+}
+
+mth::RationalFunction mth::operator*(const mth::RationalFunction &lhs, const mth::comp &rhs) {
+
+    return RationalFunction(lhs.getNumerator() * rhs, lhs.getDenominator());
+}
+
+mth::RationalFunction mth::operator*(const mth::comp &lhs, const mth::RationalFunction &rhs) {
+
+    return rhs * lhs;
+}
+
+mth::RationalFunction mth::operator*(const mth::RationalFunction &lhs, const mth::RationalFunction &rhs) {
+
+    return RationalFunction(product(lhs.getNumerator(), rhs.getNumerator()), product(lhs.getDenominator(), rhs.getDenominator()));
+}
+
+mth::RationalFunction mth::operator/(const mth::RationalFunction &lhs, const mth::comp &rhs) {
+
+    return RationalFunction(lhs.getNumerator(), lhs.getDenominator() * rhs);
+}
+
+mth::RationalFunction mth::operator/(const mth::RationalFunction &lhs, const mth::RationalFunction &rhs) {
+
+    if (rhs.getNumerator().getDegree().isInfinite()) {
+
+        throw std::invalid_argument("mth::exception: division by a zero rational function");
+    }
+
+    return RationalFunction(product(lhs.getNumerator(), rhs.getDenominator()), product(lhs.getDenominator(), rhs.getNumerator()));
+}
+
+mth::RationalFunction mth::differentiate(const mth::RationalFunction &function) {
+
+    auto &p = function.getNumerator();
+    auto &q = function.getDenominator();
+
+    return RationalFunction(product(differentiate(p), q) - product(p, differentiate(q)), product(q, q));
+}
@@ -1,13 +1,87 @@
 
-#include <numeric>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 #include <mth/mth.h>
 
 #include <mth/series.h>
+#include <mth/cache.h>
+#include <mth/summation.h>
 
 #include <mth/numeric.h>
 
-mth::Series::Series() {
+struct mth::Series::PartialCache {
+
+    CachePolicy policy;
+    Summation summation;
+
+    // Every partial sum up to the end of the dense region
+    tcache<comp> partials;
+
+    // checkpoints[k] is the partial sum at the end of chunk k
+    tcache<comp> checkpoints;
+
+    // Held while extending the caches or touching the frontier; reads of published sums don't take it
+    std::mutex mutex;
+
+    // Terms evaluated for arithmetic on the series, with a separate lock since the term function may
+    // itself read cached terms of other series while mutex is held
+    tcache<comp> terms;
+    std::mutex termMutex;
+
+    // Running sums of every dense term, and of every chunk with a checkpoint
+    // Keeping them means compensation carries across extensions rather than restarting at each one
+    Accumulator dense;
+    Accumulator chain;
+
+    // The sum of the terms from the start of the frontier's chunk up to the last partial sum computed
+    // past the dense region, so sequential access stays incremental
+    size_t frontierIndex = 0;
+    Accumulator frontier;
+    bool hasFrontier = false;
+
+    PartialCache(CachePolicy policy, Summation summation)
+        :policy(policy), summation(summation), dense(summation), chain(summation), frontier(summation) {
+
+        // A chunk size of zero would never make progress
+        if (this->policy.chunkSize == 0) this->policy.chunkSize = 1;
+    }
+
+    size_t denseLimit() const {
+
+        return policy.chunkSize * policy.denseChunks;
+    }
+
+    // Must be called with mutex held
+    void appendDense(const comp &term) {
+
+        auto index = partials.size();
+
+        dense.add(term);
+
+        auto partial = dense.total();
+
+        partials.push(partial);
+
+        if (index % policy.chunkSize == policy.chunkSize - 1) checkpoints.push(partial);
+
+        // Later chunks chain on from the whole dense region
+        if (index + 1 == denseLimit()) chain = dense;
+    }
+
+    // Must be called with mutex held
+    void appendCheckpoint(const comp &chunkTotal) {
+
+        chain.add(chunkTotal);
+        checkpoints.push(chain.total());
+    }
+};
+
+mth::Series::Series()
+    :cache(std::make_shared<PartialCache>(CachePolicy(), Summation::Naive)) {
 
     terms = [] (size_t index) {
 
@@ -18,42 +92,280 @@ mth::Series::Series() {
     isTrivial = true;
 }
 
-mth::Series::Series(std::function<comp(size_t)> terms)
-    :terms(terms) {}
+mth::Series::Series(std::function<comp(size_t)> terms, mth::CachePolicy policy)
+    :Series(terms, Summation::Naive, policy) {}
+
+mth::Series::Series(std::function<comp(size_t)> terms, mth::Summation summation, mth::CachePolicy policy)
+    :terms(terms), cache(std::make_shared<PartialCache>(policy, summation)) {}
 
 mth::comp mth::Series::getTerm(size_t index) const {
 
     return terms(index);
 }
 
+mth::comp mth::Series::getCachedTerm(size_t index) const {
+
+    auto &c = *cache;
+
+    if (index < c.terms.size()) return c.terms[index];
+
+    std::lock_guard<std::mutex> lock(c.termMutex);
+
+    for (auto i = c.terms.size(); i <= index; i++) {
+
+        c.terms.push(getTerm(i));
+    }
+
+    return c.terms[index];
+}
+
+mth::Summation mth::Series::getSummation() const {
+
+    return cache->summation;
+}
+
 mth::comp mth::Series::getPartial(size_t index) const {
 
-    mth::comp result;
+    auto &c = *cache;
+    auto chunkSize = c.policy.chunkSize;
+
+    // Published sums are read without locking
+    if (index < c.partials.size()) return c.partials[index];
 
-    // Calculate from scratch
-    if (lastPartialIndex == 0 || lastPartialIndex > index) {
+    if (index < c.denseLimit()) {
 
-        for (size_t i = 0; i <= index; i++) {
+        std::lock_guard<std::mutex> lock(c.mutex);
 
-            result += getTerm(i);
+        // Another thread may have extended the cache while we waited
+        for (auto i = c.partials.size(); i <= index; i++) {
+
+            c.appendDense(getTerm(i));
         }
-    } else if (lastPartialIndex < index) {
 
-        result = lastPartial;
-        
-        for (size_t i = lastPartialIndex + 1; i <= index; i++) {
+        return c.partials[index];
+    }
+
+    // Complete the dense region first so the checkpoints it records stay in order
+    if (c.partials.size() < c.denseLimit()) getPartial(c.denseLimit() - 1);
+
+    auto chunk = index / chunkSize;
+    auto chunkStart = chunk * chunkSize;
+    auto chunkEnd = chunkStart + chunkSize - 1;
 
-            result += getTerm(i);
+    if (index == chunkEnd && chunk < c.checkpoints.size()) return c.checkpoints[chunk];
+
+    auto current = chunkStart;
+    auto base = comp{0};
+    Accumulator accumulator(c.summation);
+
+    {
+        std::lock_guard<std::mutex> lock(c.mutex);
+
+        // Sum whole chunks to reach the checkpoint before the requested one
+        while (c.checkpoints.size() < chunk) {
+
+            c.appendCheckpoint(sumTerms(c.checkpoints.size() * chunkSize, chunkSize));
+        }
+
+        if (index == chunkEnd && chunk < c.checkpoints.size()) return c.checkpoints[chunk];
+
+        if (chunk > 0) base = c.checkpoints[chunk - 1];
+
+        // Continue from the frontier if it's in this chunk and not past index, otherwise from the checkpoint
+        if (c.hasFrontier && c.frontierIndex >= chunkStart && c.frontierIndex <= index) {
+
+            current = c.frontierIndex + 1;
+            accumulator = c.frontier;
         }
     }
 
-    lastPartialIndex = index;
-    lastPartial = result;
+    // The remaining terms within the chunk are summed without holding the lock
+    for (; current <= index; current++) {
 
-    return result;
+        accumulator.add(getTerm(current));
+    }
+
+    std::lock_guard<std::mutex> lock(c.mutex);
+
+    c.frontierIndex = index;
+    c.frontier = accumulator;
+    c.hasFrontier = true;
+
+    // The accumulator holds exactly what sumTerms would give for the whole chunk
+    if (index == chunkEnd && c.checkpoints.size() == chunk) c.appendCheckpoint(accumulator.total());
+
+    if (index == chunkEnd) return c.checkpoints[chunk];
+
+    return base + accumulator.total();
+}
+
+mth::comp mth::Series::getPartial(size_t index, mth::Execution execution) const {
+
+    // Number of dense terms each parallel task evaluates
+    constexpr size_t denseBlock = 256;
+
+    auto &c = *cache;
+    auto chunkSize = c.policy.chunkSize;
+
+    if (execution == Execution::Serial || index < c.partials.size()) return getPartial(index);
+
+    {
+        std::lock_guard<std::mutex> lock(c.mutex);
+
+        // Evaluate missing dense terms concurrently, then accumulate them in order as a serial run would
+        auto size = c.partials.size();
+        auto denseEnd = std::min(index + 1, c.denseLimit());
+
+        if (size < denseEnd) {
+
+            std::vector<comp> newTerms(denseEnd - size);
+            auto blocks = (newTerms.size() + denseBlock - 1) / denseBlock;
+
+            forEachIndex(blocks, [&] (size_t block) {
+
+                auto last = std::min(newTerms.size(), (block + 1) * denseBlock);
+
+                for (auto i = block * denseBlock; i < last; i++) {
+
+                    newTerms[i] = getTerm(size + i);
+                }
+
+            }, execution);
+
+            for (const auto &term : newTerms) {
+
+                c.appendDense(term);
+            }
+        }
+
+        // Past the dense region sum whole chunks concurrently, then chain their totals in order
+        auto chunk = index / chunkSize;
+        auto reached = c.checkpoints.size();
+
+        if (index >= c.denseLimit() && reached < chunk) {
+
+            std::vector<comp> totals(chunk - reached);
+
+            forEachIndex(totals.size(), [&] (size_t k) {
+
+                totals[k] = sumTerms((reached + k) * chunkSize, chunkSize);
+
+            }, execution);
+
+            for (const auto &total : totals) {
+
+                c.appendCheckpoint(total);
+            }
+        }
+    }
+
+    // Any remaining terms lie within a single chunk
+    return getPartial(index);
+}
+
+mth::comp mth::Series::sumTerms(size_t first, size_t count) const {
+
+    Accumulator accumulator(cache->summation);
+
+    for (auto i = first; i < first + count; i++) {
+
+        accumulator.add(getTerm(i));
+    }
+
+    return accumulator.total();
+}
+
+mth::Series::TermIterator::TermIterator(std::shared_ptr<const mth::Series> series, size_t index)
+    :series(std::move(series)), index(index) {}
+
+mth::comp mth::Series::TermIterator::operator*() const {
+
+    return series->getTerm(index);
+}
+
+mth::Series::TermIterator &mth::Series::TermIterator::operator++() {
+
+    index++;
+    return *this;
+}
+
+mth::Series::TermIterator mth::Series::TermIterator::operator++(int) {
+
+    auto copy = *this;
+    index++;
+    return copy;
+}
+
+bool mth::Series::TermIterator::operator==(const mth::Series::TermIterator &other) const {
+
+    return index == other.index;
+}
+
+bool mth::Series::TermIterator::operator!=(const mth::Series::TermIterator &other) const {
+
+    return index != other.index;
+}
+
+mth::Series::PartialIterator::PartialIterator(std::shared_ptr<const mth::Series> series, size_t index)
+    :series(std::move(series)), index(index), accumulator(this->series->getSummation()) {}
+
+void mth::Series::PartialIterator::readCurrent() const {
+
+    if (hasCurrent) return;
+
+    accumulator.add(series->getTerm(index));
+    hasCurrent = true;
+}
+
+mth::comp mth::Series::PartialIterator::operator*() const {
+
+    readCurrent();
+
+    return accumulator.total();
+}
+
+mth::Series::PartialIterator &mth::Series::PartialIterator::operator++() {
+
+    readCurrent();
+
+    index++;
+    hasCurrent = false;
+
+    return *this;
+}
+
+mth::Series::PartialIterator mth::Series::PartialIterator::operator++(int) {
+
+    auto copy = *this;
+    ++*this;
+    return copy;
+}
+
+bool mth::Series::PartialIterator::operator==(const mth::Series::PartialIterator &other) const {
+
+    return index == other.index;
+}
+
+bool mth::Series::PartialIterator::operator!=(const mth::Series::PartialIterator &other) const {
+
+    return index != other.index;
+}
+
+mth::Range<mth::Series::TermIterator> mth::Series::streamTerms(size_t count) const {
+
+    auto shared = std::make_shared<const Series>(*this);
+
+    return Range<TermIterator>(TermIterator(shared, 0), TermIterator(shared, count));
 }
 
-mth::comp mth::Series::getLimit() const {
+mth::Range<mth::Series::PartialIterator> mth::Series::streamPartials(size_t count) const {
+
+    auto shared = std::make_shared<const Series>(*this);
+
+    return Range<PartialIterator>(PartialIterator(shared, 0), PartialIterator(shared, count));
+}
+
+mth::comp mth::Series::getLimit(mth::Acceleration method) const {
 
     if (isTrivial) return trivialSum;
 
@@ -62,12 +374,108 @@ mth::comp mth::Series::getLimit() const {
         return getPartial(index);
     };
 
-    return seriesLimit(partialSequence, terms);
+    return seriesLimit(partialSequence, terms, method);
 }
 
-mth::Series mth::Series::finite(std::vector<mth::comp> terms) {
+bool mth::Series::isAlternating() const {
+
+    return mth::isAlternating(terms);
+}
+
+mth::LimitResult mth::Series::getLimit(double tolerance, std::function<double(size_t)> tailBound, size_t maxTerms) const {
+
+    // Number of consecutive term ratios that must agree before trusting a bound from them
+    constexpr size_t window = 4;
+
+    LimitResult result;
+
+    if (isTrivial) {
+
+        result.value = trivialSum;
+        result.converged = true;
+
+        return result;
+    }
+
+    Accumulator accumulator(getSummation());
+
+    auto next = getTerm(0);
+
+    // The latest ratios a_(k + 1) / a_k, oldest first
+    std::vector<comp> ratios;
+
+    for (size_t n = 0; n < maxTerms; n++) {
+
+        auto term = next;
+
+        accumulator.add(term);
+        next = getTerm(n + 1);
+
+        if (util::isZero(term.abs())) {
+
+            ratios.clear();
+
+        } else {
+
+            if (ratios.size() == window) ratios.erase(ratios.begin());
+
+            ratios.push_back(next / term);
+        }
+
+        auto bound = std::numeric_limits<double>::infinity();
+
+        if (tailBound) {
+
+            bound = tailBound(n);
+
+        } else if (ratios.size() == window) {
 
-    auto termClosure = [&] (size_t index) {
+            auto alternating = true;
+            auto shrinking = true;
+
+            auto largest = 0.0;
+
+            for (size_t i = 0; i < window; i++) {
+
+                const auto &ratio = ratios[i];
+
+                alternating = alternating && ratio.real() < 0.0 && ratio.abs() <= 1.0
+                                          && util::isZero(ratio.imag() / ratio.real());
+
+                // Ratios must stay below one and not grow, so the tail is dominated by a geometric series
+                shrinking = shrinking && ratio.abs() < 1.0 && (i == 0 || ratio.abs() <= ratios[i - 1].abs() * (1.0 + epsilon<double>));
+
+                largest = std::max(largest, ratio.abs());
+            }
+
+            // The tail of an alternating series with decreasing terms is bounded by its first term
+            if (alternating) bound = next.abs();
+
+            if (shrinking) bound = std::min(bound, next.abs() / (1.0 - largest));
+        }
+
+        if (bound <= tolerance) {
+
+            result.value = accumulator.total();
+            result.terms = n + 1;
+            result.error = bound;
+            result.converged = true;
+
+            return result;
+        }
+
+        result.error = bound;
+    }
+
+    result.value = accumulator.total();
+    result.terms = maxTerms;
+
+    return result;
+}
+
+mth::Series mth::Series::finite(std::vector<mth::comp> terms, mth::Summation summation) {
+
+    auto termClosure = [terms] (size_t index) {
 
         if (index < terms.size()) {
 
@@ -79,28 +487,180 @@ mth::Series mth::Series::finite(std::vector<mth::comp> terms) {
         }
     };
 
-    Series result(termClosure);
+    Series result(termClosure, summation);
 
     result.isTrivial = true;
-    result.trivialSum = std::accumulate(terms.begin(), terms.end(), (mth::comp) 0);
+    result.trivialSum = sum(terms, summation);
 
     return result;
 }
 
 mth::Series mth::Series::recursive(std::function<mth::comp(mth::comp)> recursion, const mth::comp &init) {
 
-    auto terms = [&] (size_t index) {
+    auto lastTerm = [recursion] (size_t, const std::vector<comp> &previous) {
+
+        return recursion(previous[0]);
+    };
+
+    return recursive(lastTerm, std::vector<comp> {init});
+}
+
+mth::Series mth::Series::recursive(std::function<mth::comp(size_t, mth::comp)> recursion, const mth::comp &init) {
+
+    auto lastTerm = [recursion] (size_t n, const std::vector<comp> &previous) {
+
+        return recursion(n, previous[0]);
+    };
+
+    return recursive(lastTerm, std::vector<comp> {init});
+}
+
+mth::Series mth::Series::recursive(std::function<mth::comp(size_t, const std::vector<mth::comp> &)> recursion, std::vector<mth::comp> initial) {
+
+    // Memoized state of the recurrence, owned by the term function
+    struct Recurrence {
 
-        comp result;
+        std::function<comp(size_t, const std::vector<comp> &)> recursion;
+        std::vector<comp> initial;
 
-        for (size_t i = 0; i < index; i++) {
+        tcache<comp> terms;
 
-            result = recursion(result);
+        // Held while extending terms, along with the window of the latest terms
+        std::mutex mutex;
+        std::vector<comp> window;
+    };
+
+    auto state = std::make_shared<Recurrence>();
+
+    state->recursion = std::move(recursion);
+    state->initial = std::move(initial);
+
+    auto order = state->initial.size();
+
+    // Without initial terms there's nothing to recur on, so the series is zero
+    if (order == 0) return Series();
+
+    auto terms = [state, order] (size_t index) {
+
+        if (index < state->terms.size()) return state->terms[index];
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+
+        for (auto n = state->terms.size(); n <= index; n++) {
+
+            auto term = n < order ? state->initial[n] : state->recursion(n, state->window);
+
+            // Keep the window at the last order terms, oldest first
+            if (state->window.size() == order) state->window.erase(state->window.begin());
+
+            state->window.push_back(term);
+            state->terms.push(term);
         }
 
-        return result;
+        return state->terms[index];
     };
 
     return Series(terms);
 }
 
+mth::Series mth::operator+(const mth::Series &lhs, const mth::Series &rhs) {
+
+    Series result([lhs, rhs] (size_t index) {
+
+        return lhs.getCachedTerm(index) + rhs.getCachedTerm(index);
+
+    }, lhs.getSummation(), lhs.cache->policy);
+
+    if (lhs.isTrivial && rhs.isTrivial) {
+
+        result.isTrivial = true;
+        result.trivialSum = lhs.trivialSum + rhs.trivialSum;
+    }
+
+    return result;
+}
+
+mth::Series mth::operator-(const mth::Series &rhs) {
+
+    return comp{-1} * rhs;
+}
+
+mth::Series mth::operator-(const mth::Series &lhs, const mth::Series &rhs) {
+
+    return lhs + (-rhs);
+}
+
+mth::Series mth::operator*(const mth::Series &lhs, const mth::comp &rhs) {
+
+    Series result([lhs, rhs] (size_t index) {
+
+        return lhs.getCachedTerm(index) * rhs;
+
+    }, lhs.getSummation(), lhs.cache->policy);
+
+    if (lhs.isTrivial) {
+
+        result.isTrivial = true;
+        result.trivialSum = lhs.trivialSum * rhs;
+    }
+
+    return result;
+}
+
+mth::Series mth::operator*(const mth::comp &lhs, const mth::Series &rhs) {
+
+    return rhs * lhs;
+}
+
+mth::Series mth::operator*(const mth::Series &lhs, const mth::Series &rhs) {
+
+    // Memoized terms of the product, owned by the term function
+    struct Convolution {
+
+        Series lhs;
+        Series rhs;
+
+        tcache<comp> terms;
+        std::mutex mutex;
+    };
+
+    auto state = std::make_shared<Convolution>();
+
+    state->lhs = lhs;
+    state->rhs = rhs;
+
+    auto summation = lhs.getSummation();
+
+    // c_n = a_0 b_n + a_1 b_(n - 1) + ... + a_n b_0, reading cached factor terms so each is evaluated once
+    auto terms = [state, summation] (size_t index) {
+
+        if (index < state->terms.size()) return state->terms[index];
+
+        std::lock_guard<std::mutex> lock(state->mutex);
+
+        for (auto n = state->terms.size(); n <= index; n++) {
+
+            Accumulator accumulator(summation);
+
+            for (size_t k = 0; k <= n; k++) {
+
+                accumulator.add(state->lhs.getCachedTerm(k) * state->rhs.getCachedTerm(n - k));
+            }
+
+            state->terms.push(accumulator.total());
+        }
+
+        return state->terms[index];
+    };
+
+    Series result(terms, summation, lhs.cache->policy);
+
+    // Cauchy products of finite series are finite, with the product of their sums
+    if (lhs.isTrivial && rhs.isTrivial) {
+
+        result.isTrivial = true;
+        result.trivialSum = lhs.trivialSum * rhs.trivialSum;
+    }
+
+    return result;
+}
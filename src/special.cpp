@@ -0,0 +1,182 @@
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+
+#include <mth/mth.h>
+
+#include <mth/special.h>
+
+// Lanczos approximation with g = 7 and nine terms, good to about 15 digits
+constexpr double lanczosG = 7.0;
+
+constexpr std::array<double, 9> lanczosCoeffs = {
+    0.99999999999980993,
+    676.5203681218851,
+    -1259.1392167224028,
+    771.32342877765313,
+    -176.61502916214059,
+    12.507343278686905,
+    -0.13857109526572012,
+    9.9843695780195716e-6,
+    1.5056327351493116e-7
+};
+
+// Below this many factors binomial coefficients too large for integers are multiplied out in doubles
+constexpr size_t directBinomial = 64;
+
+double mth::logFactorial(size_t n) {
+
+    auto value = factorial(n);
+
+    if (std::isfinite(value)) return std::log(value);
+
+    return std::lgamma(static_cast<double>(n) + 1.0);
+}
+
+double mth::logBinomial(size_t n, size_t k) {
+
+    if (k > n) return -std::numeric_limits<double>::infinity();
+
+    return logFactorial(n) - logFactorial(k) - logFactorial(n - k);
+}
+
+// Compute n choose k in integers, returning false if it doesn't fit in 64 bits
+bool integerBinomial(uint64_t n, uint64_t k, uint64_t &result) {
+
+    result = 1;
+
+    // After step i the result is (n - k + i choose i), which only grows, so the first overflow is final
+    for (uint64_t i = 1; i <= k; i++) {
+
+        // result * factor is divisible by i, and dividing out the common part first keeps it exact
+        auto common = std::gcd(result, i);
+        auto factor = (n - k + i) / (i / common);
+
+        result /= common;
+
+        if (result > std::numeric_limits<uint64_t>::max() / factor) return false;
+
+        result *= factor;
+    }
+
+    return true;
+}
+
+double mth::binomial(size_t n, size_t k) {
+
+    if (k > n) return 0.0;
+
+    k = std::min(k, n - k);
+
+    uint64_t exact;
+
+    if (integerBinomial(n, k, exact)) return static_cast<double>(exact);
+
+    if (k <= directBinomial) {
+
+        // Too large for integers, but few enough factors that multiplying in doubles only rounds k times
+        auto result = 1.0;
+
+        for (size_t i = 1; i <= k; i++) {
+
+            result = result * static_cast<double>(n - k + i) / static_cast<double>(i);
+        }
+
+        return result;
+    }
+
+    auto numerator = factorial(n);
+
+    if (std::isfinite(numerator)) return numerator / (factorial(k) * factorial(n - k));
+
+    return std::exp(logBinomial(n, k));
+}
+
+// Throws if z is a pole of gamma
+void requireNonPole(const mth::comp &z) {
+
+    if (z.imag() == 0.0 && z.real() <= 0.0 && z.real() == std::floor(z.real())) {
+
+        throw std::invalid_argument("mth::exception: gamma evaluated at a pole");
+    }
+}
+
+// Returns log(gamma(z)) for Re(z) >= 1/2
+mth::comp lanczosLog(mth::comp z) {
+
+    z -= 1.0;
+
+    auto sum = mth::comp(lanczosCoeffs[0]);
+
+    for (size_t i = 1; i < lanczosCoeffs.size(); i++) {
+
+        sum += lanczosCoeffs[i] / (z + static_cast<double>(i));
+    }
+
+    auto t = z + (lanczosG + 0.5);
+
+    return 0.5 * std::log(mth::tau<double>) + (z + 0.5) * mth::log(t) - t + mth::log(sum);
+}
+
+mth::comp mth::lgamma(const mth::comp &z) {
+
+    requireNonPole(z);
+
+    if (z.real() >= 0.5) return lanczosLog(z);
+
+    // gamma(z) gamma(1 - z) = pi / sin(pi z)
+    return std::log(pi<double>) - log(sin(pi<double> * z)) - lanczosLog(1.0 - z);
+}
+
+mth::comp mth::gamma(const mth::comp &z) {
+
+    requireNonPole(z);
+
+    if (z.real() >= 0.5) return exp(lanczosLog(z));
+
+    return pi<double> / (sin(pi<double> * z) * exp(lanczosLog(1.0 - z)));
+}
+
+std::vector<double> mth::logFactorial(const std::vector<size_t> &n, mth::Execution execution) {
+
+    std::vector<double> result(n.size());
+
+    forEachIndex(n.size(), [&] (size_t i) {
+
+        result[i] = logFactorial(n[i]);
+
+    }, execution);
+
+    return result;
+}
+
+std::vector<mth::comp> mth::lgamma(const std::vector<mth::comp> &z, mth::Execution execution) {
+
+    std::vector<comp> result(z.size());
+
+    forEachIndex(z.size(), [&] (size_t i) {
+
+        result[i] = lgamma(z[i]);
+
+    }, execution);
+
+    return result;
+}
+
+std::vector<mth::comp> mth::gamma(const std::vector<mth::comp> &z, mth::Execution execution) {
+
+    std::vector<comp> result(z.size());
+
+    forEachIndex(z.size(), [&] (size_t i) {
+
+        result[i] = gamma(z[i]);
+
+    }, execution);
+
+    return result;
+}
@@ -0,0 +1,218 @@
+
+#include <cmath>
+
+#include <mth/mth.h>
+
+#include <mth/summation.h>
+
+// Number of values summed naively before a block joins the pairwise tree
+static constexpr size_t pairwiseBlock = 32;
+
+// Number of independent accumulators used when summing arrays
+static constexpr size_t lanes = 4;
+
+// Add value to sum, collecting the rounding error in compensation
+void neumaierAdd(double &sum, double &compensation, double value) {
+
+    auto total = sum + value;
+
+    // Whichever operand is smaller lost its low order bits
+    compensation += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+
+    sum = total;
+}
+
+mth::Accumulator::Accumulator(mth::Summation method)
+    :method(method) {}
+
+void mth::Accumulator::add(const mth::comp &value) {
+
+    switch (method) {
+
+        case Summation::Naive:
+
+            sum += value;
+            break;
+
+        case Summation::Kahan:
+
+            neumaierAdd(sum.real(), compensation.real(), value.real());
+            neumaierAdd(sum.imag(), compensation.imag(), value.imag());
+            break;
+
+        case Summation::Pairwise:
+
+            block += value;
+
+            if (++blockCount < pairwiseBlock) break;
+
+            levels.push_back(block);
+            levelSizes.push_back(1);
+
+            block = comp{0};
+            blockCount = 0;
+
+            // Merge equal sized neighbours so the tree stays balanced
+            while (levels.size() >= 2 && levelSizes[levels.size() - 1] == levelSizes[levels.size() - 2]) {
+
+                auto top = levels.back();
+
+                levels.pop_back();
+                levelSizes.pop_back();
+
+                levels.back() += top;
+                levelSizes.back() *= 2;
+            }
+
+            break;
+    }
+}
+
+mth::comp mth::Accumulator::total() const {
+
+    switch (method) {
+
+        case Summation::Kahan:
+
+            return sum + compensation;
+
+        case Summation::Pairwise: {
+
+            // Smallest levels first
+            auto result = block;
+
+            for (auto level = levels.rbegin(); level != levels.rend(); level++) {
+
+                result += *level;
+            }
+
+            return result;
+        }
+
+        default:
+
+            return sum;
+    }
+}
+
+mth::Summation mth::Accumulator::getMethod() const {
+
+    return method;
+}
+
+// Sum values strictly left to right, matching an Accumulator fed the same values
+mth::comp naiveSum(const mth::comp *values, size_t count) {
+
+    auto result = mth::comp{0};
+
+    for (size_t i = 0; i < count; i++) {
+
+        result += values[i];
+    }
+
+    return result;
+}
+
+// Sum values in independent lanes, which compilers can keep in vector registers
+mth::comp naiveLanes(const mth::comp *values, size_t count) {
+
+    double real[lanes] = {};
+    double imag[lanes] = {};
+
+    size_t i = 0;
+
+    for (; i + lanes <= count; i += lanes) {
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+
+            real[lane] += values[i + lane].real();
+            imag[lane] += values[i + lane].imag();
+        }
+    }
+
+    for (; i < count; i++) {
+
+        real[0] += values[i].real();
+        imag[0] += values[i].imag();
+    }
+
+    return mth::comp::fromCartesian((real[0] + real[1]) + (real[2] + real[3]),
+                                    (imag[0] + imag[1]) + (imag[2] + imag[3]));
+}
+
+mth::comp kahanLanes(const mth::comp *values, size_t count) {
+
+    double real[lanes] = {};
+    double imag[lanes] = {};
+    double realError[lanes] = {};
+    double imagError[lanes] = {};
+
+    size_t i = 0;
+
+    for (; i + lanes <= count; i += lanes) {
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+
+            neumaierAdd(real[lane], realError[lane], values[i + lane].real());
+            neumaierAdd(imag[lane], imagError[lane], values[i + lane].imag());
+        }
+    }
+
+    for (; i < count; i++) {
+
+        neumaierAdd(real[0], realError[0], values[i].real());
+        neumaierAdd(imag[0], imagError[0], values[i].imag());
+    }
+
+    // Combine the lanes, keeping their errors compensated too
+    double realSum = 0.0;
+    double imagSum = 0.0;
+    double realTotalError = 0.0;
+    double imagTotalError = 0.0;
+
+    for (size_t lane = 0; lane < lanes; lane++) {
+
+        neumaierAdd(realSum, realTotalError, real[lane]);
+        neumaierAdd(imagSum, imagTotalError, imag[lane]);
+
+        realTotalError += realError[lane];
+        imagTotalError += imagError[lane];
+    }
+
+    return mth::comp::fromCartesian(realSum + realTotalError, imagSum + imagTotalError);
+}
+
+mth::comp pairwiseLanes(const mth::comp *values, size_t count) {
+
+    // Lanes already split the base case four ways, so it can be larger than the accumulator's blocks
+    constexpr size_t base = 4 * pairwiseBlock;
+
+    if (count <= base) return naiveLanes(values, count);
+
+    auto half = count / 2;
+
+    return pairwiseLanes(values, half) + pairwiseLanes(values + half, count - half);
+}
+
+mth::comp mth::sum(const mth::comp *values, size_t count, mth::Summation method) {
+
+    switch (method) {
+
+        case Summation::Kahan:
+
+            return kahanLanes(values, count);
+
+        case Summation::Pairwise:
+
+            return pairwiseLanes(values, count);
+
+        default:
+
+            return naiveSum(values, count);
+    }
+}
+
+mth::comp mth::sum(const std::vector<mth::comp> &values, mth::Summation method) {
+
+    return sum(values.data(), values.size(), method);
+}